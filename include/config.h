@@ -24,6 +24,8 @@
 // #define BOARD_ESP32_XBEE             // https://github.com/nebkat/esp32-xbee
 #define BOARD_SPARKFUN_ESP32_WROOM_C // https://github.com/sparkfun/SparkFun_Thing_Plus_ESP32_WROOM_C
 
+// #define NTRIP_CASTER_MEASURE_ACK // ACK time in cas_measure, reads lwIP internals, IDF 5.0 to 5.4 only
+
 #define CONFIG_LEN_MAX 128
 
 typedef enum
@@ -42,12 +44,32 @@ typedef enum
     CONFIG_BASE_LAT,
     CONFIG_BASE_LON,
     CONFIG_BASE_ALT,
+    CONFIG_CASTER_QUEUE,
+    CONFIG_CASTER_POLICY,
+    CONFIG_UART_STATUS_BAUD,
+    CONFIG_UART_RTCM3_BAUD,
+    CONFIG_CASTER_MOUNTS,
+    CONFIG_CASTER_USERS,
+    CONFIG_NTRIP_RELAY,
+    CONFIG_UDP_TARGETS,
+    CONFIG_UDP_MODE,
+    CONFIG_NTRIP_SRV_IP,
+    CONFIG_NTRIP_SRV_PORT,
+    CONFIG_NTRIP_SRV_USER,
+    CONFIG_NTRIP_SRV_PWD,
+    CONFIG_NTRIP_SRV_MNT,
+    CONFIG_NTRIP_SRV_VER,
+    CONFIG_CASTER_PACING,
+    CONFIG_CASTER_LATENCY,
+    CONFIG_CASTER_MEASURE,
+    CONFIG_CASTER_COUNTRY,
     CONFIG_MAX
 } config_t;
 
 esp_err_t config_init();
 void config_set(config_t type, const char *value);
 char *config_get(config_t type);
+config_t config_find(const char *name);
 void config_reset();
 
 #endif // ESP32_GNSS_CONFIG_H
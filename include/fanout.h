@@ -0,0 +1,51 @@
+/*
+ * This file is part of the ESP32-GNSS-Base-Station firmware, published
+ * at (https://github.com/vuquangtrong/esp32-gnss-base-station).
+ * Copyright (c) 2023 Vu Quang Trong.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ESP32_GNSS_FANOUT_H
+#define ESP32_GNSS_FANOUT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Single-producer byte ring shared by many consumers.
+ * The producer writes each byte once; every consumer keeps its own read
+ * position (a free-running byte counter) and reads the data in place.
+ * A consumer which falls more than the ring size behind is overrun.
+ */
+
+#define FANOUT_SUBSCRIBER_MAX 4
+
+typedef struct fanout_t fanout_t;
+
+// called by the producer after each write, must not block
+typedef void (*fanout_notify_t)(void *arg);
+
+fanout_t *fanout_create(size_t size);
+void fanout_write(fanout_t *fanout, const uint8_t *data, size_t len);
+
+uint32_t fanout_head(const fanout_t *fanout);
+size_t fanout_peek(const fanout_t *fanout, uint32_t pos, const uint8_t **data);
+size_t fanout_copy(const fanout_t *fanout, uint32_t pos, uint8_t *data, size_t len);
+bool fanout_overrun(const fanout_t *fanout, uint32_t pos);
+
+bool fanout_subscribe(fanout_t *fanout, fanout_notify_t notify, void *arg);
+void fanout_unsubscribe(fanout_t *fanout, fanout_notify_t notify, void *arg);
+
+#endif // ESP32_GNSS_FANOUT_H
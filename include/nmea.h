@@ -0,0 +1,44 @@
+/*
+ * This file is part of the ESP32-GNSS-Base-Station firmware, published
+ * at (https://github.com/vuquangtrong/esp32-gnss-base-station).
+ * Copyright (c) 2023 Vu Quang Trong.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ESP32_GNSS_NMEA_H
+#define ESP32_GNSS_NMEA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define NMEA_LEN_MAX 128
+
+// called with a checksum-validated sentence, without CR LF, null-terminated
+typedef void (*nmea_sentence_cb_t)(const char *sentence, size_t len, void *ctx);
+
+typedef struct nmea_parser_t
+{
+    char line[NMEA_LEN_MAX];
+    size_t len; // collected chars of the current sentence, 0 while looking for '$'
+    uint32_t checksum_errors;
+    uint32_t overflows;
+} nmea_parser_t;
+
+void nmea_parser_init(nmea_parser_t *parser);
+size_t nmea_parser_feed(nmea_parser_t *parser, const uint8_t *data, size_t len, nmea_sentence_cb_t cb, void *ctx);
+
+bool nmea_check_checksum(const char *sentence, size_t len);
+
+#endif // ESP32_GNSS_NMEA_H
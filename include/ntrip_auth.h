@@ -0,0 +1,32 @@
+/*
+ * This file is part of the ESP32-GNSS-Base-Station firmware, published
+ * at (https://github.com/vuquangtrong/esp32-gnss-base-station).
+ * Copyright (c) 2023 Vu Quang Trong.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ESP32_GNSS_NTRIP_AUTH_H
+#define ESP32_GNSS_NTRIP_AUTH_H
+
+#include <stdbool.h>
+#include <esp_err.h>
+
+typedef struct ntrip_auth_user_t ntrip_auth_user_t;
+
+esp_err_t ntrip_auth_init();
+bool ntrip_auth_required(const char *mount);
+esp_err_t ntrip_auth_acquire(const char *mount, const char *authorization, ntrip_auth_user_t **user);
+void ntrip_auth_release(ntrip_auth_user_t *user);
+
+#endif // ESP32_GNSS_NTRIP_AUTH_H
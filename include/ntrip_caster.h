@@ -19,8 +19,15 @@
 #ifndef ESP32_GNSS_NTRIP_CASTER_H
 #define ESP32_GNSS_NTRIP_CASTER_H
 
+#include <stddef.h>
 #include <esp_err.h>
 
+#include "fanout.h"
+
 esp_err_t ntrip_caster_init();
+esp_err_t ntrip_caster_mount_add(const char *name, fanout_t *fanout);
+size_t ntrip_caster_clients_info(char *buffer, size_t len);
+size_t ntrip_caster_mounts_info(char *buffer, size_t len);
+size_t ntrip_caster_latency_info(char *buffer, size_t len);
 
 #endif // ESP32_GNSS_NTRIP_CASTER_H
\ No newline at end of file
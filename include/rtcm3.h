@@ -0,0 +1,72 @@
+/*
+ * This file is part of the ESP32-GNSS-Base-Station firmware, published
+ * at (https://github.com/vuquangtrong/esp32-gnss-base-station).
+ * Copyright (c) 2023 Vu Quang Trong.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ESP32_GNSS_RTCM3_H
+#define ESP32_GNSS_RTCM3_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define RTCM3_PREAMBLE 0xD3
+#define RTCM3_HEADER_LEN 3
+#define RTCM3_CRC_LEN 3
+#define RTCM3_PAYLOAD_LEN_MAX 1023
+#define RTCM3_FRAME_LEN_MAX (RTCM3_HEADER_LEN + RTCM3_PAYLOAD_LEN_MAX + RTCM3_CRC_LEN)
+#define RTCM3_FILTER_TYPES_MAX 16
+
+// called with a whole frame: preamble, length, payload and CRC
+typedef void (*rtcm3_frame_cb_t)(const uint8_t *frame, size_t len, void *ctx);
+
+typedef struct rtcm3_parser_t
+{
+    uint8_t frame[RTCM3_FRAME_LEN_MAX];
+    size_t len;       // collected bytes of the current frame
+    size_t frame_len; // total length of the current frame, 0 until the header is complete
+    uint32_t crc_errors;
+    uint32_t dropped_bytes;
+} rtcm3_parser_t;
+
+void rtcm3_parser_init(rtcm3_parser_t *parser);
+size_t rtcm3_parser_wanted(const rtcm3_parser_t *parser);
+size_t rtcm3_parser_feed(rtcm3_parser_t *parser, const uint8_t *data, size_t len, rtcm3_frame_cb_t cb, void *ctx);
+
+/*
+ * message type filter, written as "type[:n],type[:n],..."
+ * listed types pass, keeping one frame in n, other types are dropped,
+ * an empty filter passes everything
+ */
+typedef struct rtcm3_filter_t
+{
+    size_t count;
+    uint16_t type[RTCM3_FILTER_TYPES_MAX];
+    uint16_t decimation[RTCM3_FILTER_TYPES_MAX];
+    uint16_t counter[RTCM3_FILTER_TYPES_MAX];
+} rtcm3_filter_t;
+
+bool rtcm3_filter_parse(rtcm3_filter_t *filter, const char *s);
+bool rtcm3_filter_pass(rtcm3_filter_t *filter, uint16_t type);
+
+uint32_t rtcm3_crc24q(const uint8_t *data, size_t len);
+size_t rtcm3_frame_len(const uint8_t *header);
+uint16_t rtcm3_msg_type(const uint8_t *frame);
+bool rtcm3_msm(uint16_t type);
+bool rtcm3_msm_multiple(const uint8_t *frame);
+uint32_t rtcm3_msm_epoch(const uint8_t *frame);
+
+#endif // ESP32_GNSS_RTCM3_H
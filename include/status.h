@@ -33,6 +33,9 @@ typedef enum
     STATUS_NTRIP_CAS_STATUS,
     STATUS_WIFI_STATUS,
     STATUS_BATTERY,
+    STATUS_GNSS_PVT,
+    STATUS_GNSS_SVIN,
+    STATUS_NTRIP_SRV_STATUS,
     STATUS_MAX
 } status_t;
 
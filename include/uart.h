@@ -23,7 +23,9 @@
 #include <esp_err.h>
 #include <esp_event.h>
 
-extern esp_event_base_t const UART_RTCM3_EVENT_READ;
+#include "fanout.h"
+#include "ublox.h"
+
 extern esp_event_base_t const UART_RTCM3_EVENT_WRITE;
 extern esp_event_base_t const UART_STATUS_EVENT_READ;
 extern esp_event_base_t const UART_STATUS_EVENT_WRITE;
@@ -33,10 +35,28 @@ esp_err_t uart_init();
 void uart_register_handler(esp_event_base_t event_base, esp_event_handler_t event_handler);
 void uart_unregister_handler(esp_event_base_t event_base, esp_event_handler_t event_handler);
 
-void ubx_set_default();
-void ubx_set_mode_rover();
-void ubx_set_mode_survey(const char* dur, const char* acc);
-void ubx_set_mode_fixed(const char* lat, const char* lon, const char* alt);
+typedef enum
+{
+    UBX_ACK_PENDING = 0,
+    UBX_ACK_ACK,
+    UBX_ACK_NAK,
+    UBX_ACK_TIMEOUT
+} ubx_ack_t;
+
+fanout_t *uart_rtcm3_fanout();
+
+void uart_get_nav_pvt(ubx_nav_pvt_t *pvt);
+void uart_get_nav_hpposllh(ubx_nav_hpposllh_t *pos);
+void uart_get_nav_svin(ubx_nav_svin_t *svin);
+
+esp_err_t ubx_send_cmd(const uint8_t *frame, size_t len, uint32_t timeout_ms, uint8_t retries);
+esp_err_t ubx_set_default();
+esp_err_t ubx_set_mode_rover();
+esp_err_t ubx_set_mode_survey(const char* dur, const char* acc);
+esp_err_t ubx_set_mode_fixed(const char* lat, const char* lon, const char* alt);
+esp_err_t ubx_set_mode_fixed_xyz(const char* x, const char* y, const char* z);
+esp_err_t ubx_set_mode_fixed_llh(int64_t lat, int64_t lon, int64_t height);
+esp_err_t ubx_set_mode_fixed_ecef(int64_t x, int64_t y, int64_t z);
 void ubx_write_rtcm3(const char* buffer, size_t len);
 
 #endif // ESP32_GNSS_UART_H
\ No newline at end of file
@@ -19,8 +19,151 @@
 #ifndef ESP32_GNSS_UBLOX_H
 #define ESP32_GNSS_UBLOX_H
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
+#define UBX_SYNC1 0xB5
+#define UBX_SYNC2 0x62
+#define UBX_HEADER_LEN 6 // sync1, sync2, class, id, length
+#define UBX_CHECKSUM_LEN 2
+#define UBX_PAYLOAD_LEN_MAX 1024
+#define UBX_FRAME_LEN_MAX (UBX_HEADER_LEN + UBX_PAYLOAD_LEN_MAX + UBX_CHECKSUM_LEN)
+#define UBX_VALSET_KEYS_MAX 64 // key value pairs in one CFG-VALSET
+
+#define UBX_CLASS_NAV 0x01
+#define UBX_CLASS_ACK 0x05
+#define UBX_CLASS_CFG 0x06
+#define UBX_CLASS_MON 0x0A
+
+#define UBX_ID_ACK_NAK 0x00
+#define UBX_ID_ACK_ACK 0x01
+#define UBX_ID_CFG_VALSET 0x8A
+#define UBX_ID_NAV_PVT 0x07
+#define UBX_ID_NAV_HPPOSLLH 0x14
+#define UBX_ID_NAV_SVIN 0x3B
+#define UBX_ID_MON_VER 0x04
+
+#define UBX_NAV_PVT_LEN 92
+#define UBX_NAV_HPPOSLLH_LEN 36
+#define UBX_NAV_SVIN_LEN 40
+
+#define UBX_LAYER_RAM 1
+#define UBX_LAYER_BBR 2
+
+// CFG-VALSET keys used by the firmware, the value size is in bits 28-30
+#define UBX_KEY_TMODE_MODE 0x20030001
+#define UBX_KEY_TMODE_POS_TYPE 0x20030002
+#define UBX_KEY_TMODE_ECEF_X 0x40030003
+#define UBX_KEY_TMODE_ECEF_Y 0x40030004
+#define UBX_KEY_TMODE_ECEF_Z 0x40030005
+#define UBX_KEY_TMODE_ECEF_X_HP 0x20030006
+#define UBX_KEY_TMODE_ECEF_Y_HP 0x20030007
+#define UBX_KEY_TMODE_ECEF_Z_HP 0x20030008
+#define UBX_KEY_TMODE_LAT 0x40030009
+#define UBX_KEY_TMODE_LON 0x4003000a
+#define UBX_KEY_TMODE_HEIGHT 0x4003000b
+#define UBX_KEY_TMODE_LAT_HP 0x2003000c
+#define UBX_KEY_TMODE_LON_HP 0x2003000d
+#define UBX_KEY_TMODE_HEIGHT_HP 0x2003000e
+#define UBX_KEY_TMODE_FIXED_POS_ACC 0x4003000f
+#define UBX_KEY_UART2OUTPROT_RTCM3X 0x10760004
+
+#define UBX_TMODE_MODE_DISABLED 0
+#define UBX_TMODE_MODE_SURVEY_IN 1
+#define UBX_TMODE_MODE_FIXED 2
+#define UBX_TMODE_POS_TYPE_ECEF 0
+#define UBX_TMODE_POS_TYPE_LLH 1
+
+// called with the class, the id and the payload of a whole frame with a valid checksum
+typedef void (*ubx_frame_cb_t)(uint8_t cls, uint8_t id, const uint8_t *payload, size_t len, void *ctx);
+
+typedef struct ubx_parser_t
+{
+    uint8_t frame[UBX_FRAME_LEN_MAX];
+    size_t len;       // collected bytes of the current frame
+    size_t frame_len; // total length of the current frame, 0 until the header is complete
+    uint32_t checksum_errors;
+} ubx_parser_t;
+
+// UBX-NAV-PVT: navigation position velocity time solution
+typedef struct __attribute__((packed)) ubx_nav_pvt_t
+{
+    uint32_t iTOW;    // ms
+    uint16_t year;
+    uint8_t month;
+    uint8_t day;
+    uint8_t hour;
+    uint8_t min;
+    uint8_t sec;
+    uint8_t valid;
+    uint32_t tAcc;    // ns
+    int32_t nano;     // ns
+    uint8_t fixType;
+    uint8_t flags;
+    uint8_t flags2;
+    uint8_t numSV;
+    int32_t lon;      // 1e-7 deg
+    int32_t lat;      // 1e-7 deg
+    int32_t height;   // mm
+    int32_t hMSL;     // mm
+    uint32_t hAcc;    // mm
+    uint32_t vAcc;    // mm
+    int32_t velN;     // mm/s
+    int32_t velE;     // mm/s
+    int32_t velD;     // mm/s
+    int32_t gSpeed;   // mm/s
+    int32_t headMot;  // 1e-5 deg
+    uint32_t sAcc;    // mm/s
+    uint32_t headAcc; // 1e-5 deg
+    uint16_t pDOP;    // 0.01
+    uint16_t flags3;
+    uint8_t reserved0[4];
+    int32_t headVeh;  // 1e-5 deg
+    int16_t magDec;   // 1e-2 deg
+    uint16_t magAcc;  // 1e-2 deg
+} ubx_nav_pvt_t;
+
+// UBX-NAV-HPPOSLLH: high precision geodetic position solution
+typedef struct __attribute__((packed)) ubx_nav_hpposllh_t
+{
+    uint8_t version;
+    uint8_t reserved0[2];
+    uint8_t flags;
+    uint32_t iTOW;    // ms
+    int32_t lon;      // 1e-7 deg
+    int32_t lat;      // 1e-7 deg
+    int32_t height;   // mm
+    int32_t hMSL;     // mm
+    int8_t lonHp;     // 1e-9 deg
+    int8_t latHp;     // 1e-9 deg
+    int8_t heightHp;  // 0.1 mm
+    int8_t hMSLHp;    // 0.1 mm
+    uint32_t hAcc;    // 0.1 mm
+    uint32_t vAcc;    // 0.1 mm
+} ubx_nav_hpposllh_t;
+
+// UBX-NAV-SVIN: survey-in data
+typedef struct __attribute__((packed)) ubx_nav_svin_t
+{
+    uint8_t version;
+    uint8_t reserved0[3];
+    uint32_t iTOW;    // ms
+    uint32_t dur;     // s
+    int32_t meanX;    // cm
+    int32_t meanY;    // cm
+    int32_t meanZ;    // cm
+    int8_t meanXHP;   // 0.1 mm
+    int8_t meanYHP;   // 0.1 mm
+    int8_t meanZHP;   // 0.1 mm
+    uint8_t reserved1;
+    uint32_t meanAcc; // 0.1 mm
+    uint32_t obs;
+    uint8_t valid;
+    uint8_t active;
+    uint8_t reserved2[2];
+} ubx_nav_svin_t;
+
 typedef enum
 {
     GNSS_MODE_ROVER = 0,
@@ -28,6 +171,21 @@ typedef enum
     GNSS_MODE_FIXED
 } gnss_mode_t;
 
-uint32_t ubx_gen_cmd(const char *msg, uint8_t *buff);
+uint32_t ubx_gen_cmd(const char *msg, uint8_t *buff, uint32_t len);
+uint32_t ubx_gen_poll(uint8_t cls, uint8_t id, uint8_t *buff);
+
+uint8_t *ubx_valset_begin(uint8_t *buff, uint8_t layer);
+uint8_t *ubx_valset_add(uint8_t *q, uint32_t key, int64_t value);
+uint8_t *ubx_valset_add_hp(uint8_t *q, uint32_t key, uint32_t key_hp, int64_t value);
+uint32_t ubx_valset_end(uint8_t *buff, uint8_t *q);
+
+bool ubx_parse_fixed(const char *s, int decimals, int64_t *value);
+
+void ubx_parser_init(ubx_parser_t *parser);
+size_t ubx_parser_feed(ubx_parser_t *parser, const uint8_t *data, size_t len, ubx_frame_cb_t cb, void *ctx);
+
+bool ubx_decode_nav_pvt(const uint8_t *payload, size_t len, ubx_nav_pvt_t *pvt);
+bool ubx_decode_nav_hpposllh(const uint8_t *payload, size_t len, ubx_nav_hpposllh_t *pos);
+bool ubx_decode_nav_svin(const uint8_t *payload, size_t len, ubx_nav_svin_t *svin);
 
 #endif // ESP32_GNSS_UBLOX_H
\ No newline at end of file
@@ -77,6 +77,7 @@
     }
 
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
 
 #define NEWLINE "\n"
 #define CARRET "\r"
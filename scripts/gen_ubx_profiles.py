@@ -0,0 +1,151 @@
+import os
+import re
+import struct
+
+# compile receiver profiles (profiles/*.csv, one "key,value" per line) into CFG-VALSET frames
+# the key table is read from src/ublox.c, so that the firmware and the profiles always agree
+
+profiles_path = r'profiles'
+ublox_source = r'src/ublox.c'
+output_source = r'src/ubx_profiles.c'
+output_header = r'include/ubx_profiles.h'
+
+VALSET_KEYS_MAX = 64  # key value pairs in one CFG-VALSET, see UBX_VALSET_KEYS_MAX
+VALSET_LAYER_RAM = 1
+
+# value formats by field type
+FORMATS = {
+    'FU1': '<B', 'FI1': '<b',
+    'FU2': '<H', 'FI2': '<h',
+    'FU4': '<I', 'FI4': '<i',
+    'FU8': '<Q',
+    'FR4': '<f', 'FR8': '<d',
+}
+
+# value size in bits 28-30 of a key id
+SIZE_FORMATS = {1: '<B', 2: '<B', 3: '<H', 4: '<I', 5: '<Q'}
+
+LICENSE = """/*
+ * This file is part of the ESP32-GNSS-Base-Station firmware, published
+ * at (https://github.com/vuquangtrong/esp32-gnss-base-station).
+ * Copyright (c) 2023 Vu Quang Trong.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// generated by scripts/gen_ubx_profiles.py from profiles/*.csv, do not edit
+"""
+
+
+def load_keys(filename):
+    """Read {name: (id, type)} from the VALSET_KEYS table"""
+    with open(filename) as f:
+        source = f.read()
+    pattern = r'\{"([^"]+)",\s*(0x[0-9a-fA-F]+),\s*(F\w+)\}'
+    return {name: (int(key, 16), type) for name, key, type in re.findall(pattern, source)}
+
+
+def parse_value(value, fmt):
+    if fmt in ('<f', '<d'):
+        return float(value)
+    value = int(value, 16) if value.lower().startswith('0x') else int(value)
+    # keep the bits of negative values for unsigned fields, as ubx_gen_cmd does
+    if fmt[1].isupper():
+        value &= (1 << (8 * struct.calcsize(fmt))) - 1
+    return value
+
+
+def load_profile(filename, keys):
+    """Return the list of (key id, value bytes) of a profile"""
+    items = []
+    with open(filename) as f:
+        for number, line in enumerate(f, 1):
+            line = line.strip()
+            if not line or line.startswith('#'):
+                continue
+            name, value = [field.strip() for field in line.split(',', 1)]
+            if name.lower().startswith('0x'):
+                key = int(name, 16)
+                fmt = SIZE_FORMATS.get((key >> 28) & 0x07)
+            elif name.startswith('CFG-') and name[4:] in keys:
+                key, type = keys[name[4:]]
+                fmt = FORMATS.get(type)
+            else:
+                raise ValueError(f'{filename}:{number}: unknown key {name}')
+            if fmt is None:
+                raise ValueError(f'{filename}:{number}: unsupported type of {name}')
+            items.append((key, struct.pack(fmt, parse_value(value, fmt))))
+    return items
+
+
+def checksum(data):
+    cka = ckb = 0
+    for byte in data:
+        cka = (cka + byte) & 0xFF
+        ckb = (ckb + cka) & 0xFF
+    return bytes([cka, ckb])
+
+
+def valset(items):
+    """Build CFG-VALSET frames of up to VALSET_KEYS_MAX items"""
+    frames = b''
+    for i in range(0, len(items), VALSET_KEYS_MAX):
+        payload = bytes([0, VALSET_LAYER_RAM, 0, 0])
+        for key, value in items[i:i + VALSET_KEYS_MAX]:
+            payload += struct.pack('<I', key) + value
+        body = bytes([0x06, 0x8A]) + struct.pack('<H', len(payload)) + payload
+        frames += bytes([0xB5, 0x62]) + body + checksum(body)
+    return frames
+
+
+def c_array(name, data):
+    lines = [f'const uint8_t {name}[] = {{']
+    for i in range(0, len(data), 16):
+        lines.append('    ' + ' '.join(f'0x{byte:02x},' for byte in data[i:i + 16]))
+    lines.append('};')
+    lines.append(f'const size_t {name}_LEN = sizeof({name});')
+    return '\n'.join(lines)
+
+
+def write_if_changed(filename, content):
+    if os.path.isfile(filename):
+        with open(filename) as f:
+            if f.read() == content:
+                return
+    print(f"Generating {filename}")
+    with open(filename, 'w') as f:
+        f.write(content)
+
+
+keys = load_keys(ublox_source)
+profiles = []
+
+for path in sorted(os.listdir(profiles_path)):
+    file = os.path.join(profiles_path, path)
+    if os.path.isfile(file) and file.endswith('.csv'):
+        name = 'UBX_PROFILE_' + os.path.splitext(path)[0].upper()
+        profiles.append((name, file, valset(load_profile(file, keys))))
+
+source = LICENSE + '\n#include "ubx_profiles.h"\n'
+header = LICENSE + '\n#ifndef ESP32_GNSS_UBX_PROFILES_H\n#define ESP32_GNSS_UBX_PROFILES_H\n\n'
+header += '#include <stddef.h>\n#include <stdint.h>\n\n'
+header += '// each profile is a sequence of CFG-VALSET frames\n'
+
+for name, file, data in profiles:
+    source += f'\n// {file}\n' + c_array(name, data) + '\n'
+    header += f'extern const uint8_t {name}[];\nextern const size_t {name}_LEN;\n'
+
+header += '\n#endif // ESP32_GNSS_UBX_PROFILES_H\n'
+
+write_if_changed(output_source, source)
+write_if_changed(output_header, header)
@@ -0,0 +1,173 @@
+import argparse
+import base64
+import selectors
+import socket
+import statistics
+import time
+
+# fake rovers for the caster: open more and more streaming clients on one mountpoint,
+# and measure how late each client gets each MSM frame compared to the first client which got it
+#
+#   python scripts/ntrip_load.py 192.168.4.1 --mount BASE --counts 1,4,8,16,24 --duration 30
+
+RTCM3_PREAMBLE = 0xD3
+
+
+def crc24q(data):
+    crc = 0
+    for byte in data:
+        crc ^= byte << 16
+        for _ in range(8):
+            crc <<= 1
+            if crc & 0x1000000:
+                crc ^= 0x1864CFB
+    return crc & 0xFFFFFF
+
+
+def msm_key(frame):
+    """(type, epoch time) of an MSM frame, None for other frames"""
+    payload = frame[3:-3]
+    if len(payload) < 7:
+        return None
+    msg_type = (payload[0] << 4) | (payload[1] >> 4)
+    if not (1071 <= msg_type <= 1137 and 1 <= msg_type % 10 <= 7):
+        return None
+    epoch = int.from_bytes(payload[3:7], 'big') >> 2
+    return msg_type, epoch
+
+
+class Rover:
+    def __init__(self, args, index):
+        self.index = index
+        self.raw = b''     # response header, then partial chunks in v2
+        self.buffer = b''  # RTCM3 stream
+        self.header = False
+        self.chunked = args.v2
+        self.arrivals = {}  # msm key -> arrival time
+        self.frames = 0
+        self.crc_errors = 0
+        self.sock = socket.create_connection((args.host, args.port), timeout=5)
+        self.sock.setblocking(False)
+
+        request = f'GET /{args.mount} HTTP/1.1\r\nHost: {args.host}\r\nUser-Agent: NTRIP ntrip_load\r\n'
+        if args.v2:
+            request += 'Ntrip-Version: Ntrip/2.0\r\n'
+        if args.user:
+            credential = base64.b64encode(f'{args.user}:{args.password}'.encode()).decode()
+            request += f'Authorization: Basic {credential}\r\n'
+        self.sock.sendall((request + '\r\n').encode())
+
+    def read(self, now):
+        data = self.sock.recv(65536)
+        if not data:
+            return False
+
+        if not self.header:
+            self.raw += data
+            end = self.raw.find(b'\r\n\r\n')
+            if end < 0:
+                return True
+            status = self.raw[:end].split(b'\r\n')[0]
+            if b'200' not in status:
+                raise RuntimeError(f'rover {self.index}: {status.decode(errors="replace")}')
+            data = self.raw[end + 4:]
+            self.raw = b''
+            self.header = True
+
+        if self.chunked:
+            self.dechunk(data)
+        else:
+            self.buffer += data
+        self.parse(now)
+        return True
+
+    def dechunk(self, data):
+        """move whole chunk payloads to the frame buffer, keep a partial chunk in raw"""
+        self.raw += data
+        while True:
+            end = self.raw.find(b'\r\n')
+            if end < 0:
+                return
+            size = int(self.raw[:end], 16)
+            if len(self.raw) < end + 2 + size + 2:
+                return
+            self.buffer += self.raw[end + 2:end + 2 + size]
+            self.raw = self.raw[end + 2 + size + 2:]
+
+    def parse(self, now):
+        while True:
+            start = self.buffer.find(bytes([RTCM3_PREAMBLE]))
+            if start < 0:
+                # keep-alives and other bytes between frames
+                self.buffer = b''
+                return
+            self.buffer = self.buffer[start:]
+            if len(self.buffer) < 3:
+                return
+            length = ((self.buffer[1] & 0x03) << 8) | self.buffer[2]
+            if len(self.buffer) < length + 6:
+                return
+            frame = self.buffer[:length + 6]
+            if crc24q(frame[:-3]) != int.from_bytes(frame[-3:], 'big'):
+                self.crc_errors += 1
+                self.buffer = self.buffer[1:]
+                continue
+            self.buffer = self.buffer[length + 6:]
+            self.frames += 1
+            key = msm_key(frame)
+            if key is not None:
+                self.arrivals.setdefault(key, now)
+
+
+def percentile(values, p):
+    values = sorted(values)
+    return values[min(len(values) - 1, int(len(values) * p))]
+
+
+def run(args, count):
+    rovers = [Rover(args, i) for i in range(count)]
+    selector = selectors.DefaultSelector()
+    for rover in rovers:
+        selector.register(rover.sock, selectors.EVENT_READ, rover)
+
+    end = time.monotonic() + args.duration
+    while time.monotonic() < end:
+        for key, _ in selector.select(timeout=0.1):
+            rover = key.data
+            if not rover.read(time.monotonic()):
+                raise RuntimeError(f'rover {rover.index} closed')
+
+    for rover in rovers:
+        rover.sock.close()
+
+    # delay of each client behind the first one, for the frames which all clients got
+    keys = set.intersection(*(set(rover.arrivals) for rover in rovers))
+    delays = {rover.index: [] for rover in rovers}
+    for key in keys:
+        first = min(rover.arrivals[key] for rover in rovers)
+        for rover in rovers:
+            delays[rover.index].append((rover.arrivals[key] - first) * 1000)
+
+    all_delays = [d for values in delays.values() for d in values] or [0]
+    worst = max(rovers, key=lambda r: statistics.mean(delays[r.index] or [0]))
+    print(f'{count:7} {len(keys):6} {sum(r.frames for r in rovers):7} {sum(r.crc_errors for r in rovers):4} '
+          f'{statistics.mean(all_delays):8.1f} {percentile(all_delays, 0.95):8.1f} {max(all_delays):8.1f} '
+          f'{worst.index:6} {statistics.mean(delays[worst.index] or [0]):8.1f}')
+
+
+parser = argparse.ArgumentParser(description='Caster load test with fake rovers')
+parser.add_argument('host')
+parser.add_argument('--port', type=int, default=2101)
+parser.add_argument('--mount', default='BASE')
+parser.add_argument('--user', default='')
+parser.add_argument('--password', default='')
+parser.add_argument('--v2', action='store_true', help='NTRIP v2, chunked stream')
+parser.add_argument('--counts', default='1,4,8,16,24', help='client counts to run, one after the other')
+parser.add_argument('--duration', type=float, default=30, help='seconds per client count')
+args = parser.parse_args()
+
+# delays are in ms, behind the first client which got the same MSM frame
+print('clients   msms  frames  crc  mean_ms   p95_ms   max_ms  worst  worst_ms')
+for count in [int(c) for c in args.counts.split(',')]:
+    run(args, count)
+    time.sleep(1)  # let the caster free the slots
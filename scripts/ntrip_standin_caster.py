@@ -0,0 +1,228 @@
+import argparse
+import base64
+import socket
+import time
+
+# local stand-in caster for the NTRIP server of the base station:
+# accept its SOURCE (v1) or POST (v2) connection, record each received frame with its arrival time,
+# check that each MSM epoch arrives in one write, and follow a plan of refused and dropped connections
+# to check the reconnect backoff of src/ntrip_server.c
+#
+#   python scripts/ntrip_standin_caster.py --plan refuse,refuse,refuse,drop:10,ok --log frames.log
+#
+# plan steps, one per connection:
+#   refuse   answer with an error, then close
+#   drop:N   stream for N seconds, then close
+#   ok       stream until the end
+
+RTCM3_PREAMBLE = 0xD3
+
+# same values as src/ntrip_server.c
+BACKOFF_MIN_MS = 1000
+BACKOFF_MAX_MS = 64000
+STABLE_MS = 60000
+
+
+def crc24q(data):
+    crc = 0
+    for byte in data:
+        crc ^= byte << 16
+        for _ in range(8):
+            crc <<= 1
+            if crc & 0x1000000:
+                crc ^= 0x1864CFB
+    return crc & 0xFFFFFF
+
+
+def msm_info(frame):
+    """(epoch time, multiple message bit) of an MSM frame, None for other frames"""
+    payload = frame[3:-3]
+    if len(payload) < 7:
+        return None
+    msg_type = (payload[0] << 4) | (payload[1] >> 4)
+    if not (1071 <= msg_type <= 1137 and 1 <= msg_type % 10 <= 7):
+        return None
+    epoch = int.from_bytes(payload[3:7], 'big') >> 2
+    return epoch, bool(payload[6] & 0x02)
+
+
+class Connection:
+    def __init__(self, sock, step, log):
+        self.sock = sock
+        self.step = step
+        self.log = log
+        self.raw = b''     # request header, then partial chunks in v2
+        self.buffer = b''  # RTCM3 stream
+        self.chunked = False
+        self.writes = 0      # recv() calls in v1, chunks in v2
+        self.frames = 0
+        self.crc_errors = 0
+        self.split_chunks = 0  # v2 chunks which do not hold whole frames
+        self.epoch = None      # (epoch time, first write) of the epoch being received
+        self.epochs_whole = 0
+        self.epochs_split = 0
+
+    def handshake(self, args):
+        # both SOURCE and POST requests end with an empty line
+        while b'\r\n\r\n' not in self.raw:
+            data = self.sock.recv(4096)
+            if not data:
+                return False
+            self.raw += data
+
+        header, _, self.raw = self.raw.partition(b'\r\n\r\n')
+        lines = header.decode(errors='replace').split('\r\n')
+        request = lines[0]
+        credential = ''
+        for line in lines[1:]:
+            name, _, value = line.partition(':')
+            if name.lower() == 'authorization':
+                credential = base64.b64decode(value.split()[-1]).decode(errors='replace')
+            if name.lower() == 'transfer-encoding' and 'chunked' in value.lower():
+                self.chunked = True
+        if request.startswith('SOURCE'):
+            credential = request.split()[1]
+        v2 = request.startswith('POST')
+        print(f'  request: {request}, credential: {credential}')
+
+        if self.step == 'refuse' or (args.password and credential.split(':')[-1] != args.password):
+            self.sock.sendall(b'HTTP/1.1 401 Unauthorized\r\n\r\n' if v2 else b'ERROR - Bad Password\r\n')
+            return False
+
+        self.sock.sendall(b'HTTP/1.1 200 OK\r\nNtrip-Version: Ntrip/2.0\r\n\r\n' if v2 else b'ICY 200 OK\r\n')
+        return True
+
+    def stream(self, duration):
+        self.sock.settimeout(0.5)
+        end = time.monotonic() + duration
+        data, self.raw = self.raw, b''
+        while time.monotonic() < end:
+            if data:
+                self.receive(data, time.monotonic())
+            try:
+                data = self.sock.recv(65536)
+            except socket.timeout:
+                data = b''
+                continue
+            if not data:
+                print('  closed by the NTRIP server')
+                return
+
+    def receive(self, data, now):
+        if not self.chunked:
+            self.writes += 1
+            self.buffer += data
+            self.parse(now)
+            return
+
+        self.raw += data
+        while True:
+            end = self.raw.find(b'\r\n')
+            if end < 0:
+                return
+            size = int(self.raw[:end], 16)
+            if len(self.raw) < end + 2 + size + 2:
+                return
+            self.writes += 1
+            self.buffer += self.raw[end + 2:end + 2 + size]
+            self.raw = self.raw[end + 2 + size + 2:]
+            self.parse(now)
+            if self.buffer:
+                self.split_chunks += 1
+
+    def parse(self, now):
+        while True:
+            start = self.buffer.find(bytes([RTCM3_PREAMBLE]))
+            if start < 0:
+                self.buffer = b''
+                return
+            self.buffer = self.buffer[start:]
+            if len(self.buffer) < 3:
+                return
+            length = ((self.buffer[1] & 0x03) << 8) | self.buffer[2]
+            if len(self.buffer) < length + 6:
+                return
+            frame = self.buffer[:length + 6]
+            if crc24q(frame[:-3]) != int.from_bytes(frame[-3:], 'big'):
+                self.crc_errors += 1
+                self.buffer = self.buffer[1:]
+                continue
+            self.buffer = self.buffer[length + 6:]
+            self.frame(frame, now)
+
+    def frame(self, frame, now):
+        self.frames += 1
+        msg_type = (frame[3] << 4) | (frame[4] >> 4)
+        info = msm_info(frame)
+        if self.log:
+            epoch = '' if info is None else f' {info[0]}{"+" if info[1] else ""}'
+            print(f'{now:.6f} {self.writes} {msg_type} {len(frame)}{epoch}', file=self.log)
+        if info is None:
+            return
+
+        epoch, multiple = info
+        if self.epoch is None or self.epoch[0] != epoch:
+            self.epoch = (epoch, self.writes)
+        if not multiple:
+            # last MSM of the epoch, it must have come in the same write as the first one
+            if self.epoch[1] == self.writes:
+                self.epochs_whole += 1
+            else:
+                self.epochs_split += 1
+            self.epoch = None
+
+
+def expected_backoffs(durations):
+    """reconnect delays of src/ntrip_server.c after connections of the given durations"""
+    backoff = BACKOFF_MIN_MS
+    delays = []
+    for duration in durations:
+        if duration * 1000 >= STABLE_MS:
+            backoff = BACKOFF_MIN_MS
+        delays.append(backoff)
+        backoff = min(backoff * 2, BACKOFF_MAX_MS)
+    return delays
+
+
+parser = argparse.ArgumentParser(description='Stand-in caster for the NTRIP server')
+parser.add_argument('--port', type=int, default=2101)
+parser.add_argument('--password', default='', help='refuse other passwords')
+parser.add_argument('--plan', default='refuse,refuse,refuse,drop:10,ok', help='one step per connection')
+parser.add_argument('--duration', type=float, default=60, help='seconds of the last ok step')
+parser.add_argument('--log', help='file to record each frame: time, write, type, length, epoch')
+args = parser.parse_args()
+
+log = open(args.log, 'w') if args.log else None
+server = socket.socket()
+server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+server.bind(('', args.port))
+server.listen(1)
+print(f'listening on {args.port}, plan {args.plan}')
+
+durations = []  # how long each connection lasted
+gaps = []       # from the end of each connection to the next one
+closed = None
+for step in args.plan.split(','):
+    sock, address = server.accept()
+    start = time.monotonic()
+    if closed is not None:
+        gaps.append((start - closed) * 1000)
+    print(f'connection {len(durations) + 1} from {address[0]}: {step}')
+
+    connection = Connection(sock, step, log)
+    if connection.handshake(args):
+        connection.stream(float(step.split(':')[1]) if step.startswith('drop:') else args.duration)
+        print(f'  {connection.writes} writes, {connection.frames} frames, {connection.crc_errors} CRC errors')
+        if connection.chunked:
+            print(f'  chunks with partial frames: {connection.split_chunks}')
+        print(f'  epochs in one write: {connection.epochs_whole}, split: {connection.epochs_split}')
+
+    sock.close()
+    closed = time.monotonic()
+    durations.append(closed - start)
+
+# the server waits its backoff after each closed connection, a short margin for the reconnection itself
+print('reconnect   gap_ms  expected_ms')
+for i, (gap, expected) in enumerate(zip(gaps, expected_backoffs(durations))):
+    mark = '' if expected <= gap <= expected * 1.1 + 500 else '  <- off'
+    print(f'{i + 1:4} -> {i + 2:<4} {gap:8.0f} {expected:12}{mark}')
@@ -61,6 +61,10 @@ def config():
 
     if str(request.query_string, 'ascii') == "ntrip_cli_get_mnts":
         return (["0\rABC\rDEF","1\rABC\rDEF"])[randint(0,1)]
+
+    if str(request.query_string, 'ascii') == "ntrip_cas_clients":
+        return "54 0 0 0" + newline + \
+            "55 " + str(randint(0, 4096)) + " " + str(randint(0, 10)) + " " + str(randint(0, 5000)) + newline
     
     return \
         "hostname" + newline + \
@@ -46,6 +46,25 @@ static char config_name[CONFIG_MAX][CONFIG_LEN_MAX / 2] = {
     "base_lat",
     "base_lon",
     "base_alt",
+    "cas_queue",
+    "cas_policy",
+    "uart1_baud",
+    "uart2_baud",
+    "cas_mounts",
+    "cas_users",
+    "ntrip_relay",
+    "udp_targets",
+    "udp_mode",
+    "nsrv_ip",
+    "nsrv_port",
+    "nsrv_user",
+    "nsrv_pwd",
+    "nsrv_mnt",
+    "nsrv_ver",
+    "cas_pacing",
+    "cas_latency",
+    "cas_measure",
+    "cas_country",
 };
 
 esp_err_t config_init()
@@ -111,6 +130,19 @@ char *config_get(config_t type)
     return config[type];
 }
 
+// return CONFIG_MAX if there is no config with that name
+config_t config_find(const char *name)
+{
+    for (size_t type = CONFIG_START; type < CONFIG_MAX; type++)
+    {
+        if (strcmp(config_name[type], name) == 0)
+        {
+            return type;
+        }
+    }
+    return CONFIG_MAX;
+}
+
 void config_reset()
 {
     esp_err_t err = nvs_flash_erase();
@@ -0,0 +1,186 @@
+/*
+ * This file is part of the ESP32-GNSS-Base-Station firmware, published
+ * at (https://github.com/vuquangtrong/esp32-gnss-base-station).
+ * Copyright (c) 2023 Vu Quang Trong.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fanout.h"
+
+// arg is set before notify is published, the producer reads notify first
+typedef struct fanout_subscriber_t
+{
+    _Atomic fanout_notify_t notify;
+    void *arg;
+} fanout_subscriber_t;
+
+struct fanout_t
+{
+    uint8_t *buffer;
+    uint32_t mask;
+    _Atomic uint32_t head;    // end of published data
+    _Atomic uint32_t reserve; // end of data being written, head <= reserve
+    fanout_subscriber_t subscribers[FANOUT_SUBSCRIBER_MAX];
+};
+
+// size is rounded up to a power of 2
+fanout_t *fanout_create(size_t size)
+{
+    size_t capacity = 1;
+    while (capacity < size)
+    {
+        capacity <<= 1;
+    }
+
+    fanout_t *fanout = calloc(1, sizeof(fanout_t));
+    if (fanout == NULL)
+    {
+        return NULL;
+    }
+
+    fanout->buffer = calloc(capacity, sizeof(uint8_t));
+    if (fanout->buffer == NULL)
+    {
+        free(fanout);
+        return NULL;
+    }
+
+    fanout->mask = capacity - 1;
+    atomic_init(&fanout->head, 0);
+    atomic_init(&fanout->reserve, 0);
+    return fanout;
+}
+
+void fanout_write(fanout_t *fanout, const uint8_t *data, size_t len)
+{
+    uint32_t size = fanout->mask + 1;
+    uint32_t head = atomic_load_explicit(&fanout->head, memory_order_relaxed);
+
+    if (len > size)
+    {
+        data += len - size;
+        len = size;
+    }
+
+    // announce the region which is about to be overwritten,
+    // the fence keeps the copies below from being seen before the new reserve
+    atomic_store_explicit(&fanout->reserve, head + len, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    uint32_t offset = head & fanout->mask;
+    size_t n = size - offset;
+    if (n > len)
+    {
+        n = len;
+    }
+    memcpy(fanout->buffer + offset, data, n);
+    memcpy(fanout->buffer, data + n, len - n);
+
+    atomic_store_explicit(&fanout->head, head + len, memory_order_release);
+
+    for (int i = 0; i < FANOUT_SUBSCRIBER_MAX; i++)
+    {
+        fanout_notify_t notify = atomic_load_explicit(&fanout->subscribers[i].notify, memory_order_acquire);
+        if (notify)
+        {
+            notify(fanout->subscribers[i].arg);
+        }
+    }
+}
+
+uint32_t fanout_head(const fanout_t *fanout)
+{
+    return atomic_load_explicit(&fanout->head, memory_order_acquire);
+}
+
+// contiguous bytes readable in place at pos, up to the end of the ring
+size_t fanout_peek(const fanout_t *fanout, uint32_t pos, const uint8_t **data)
+{
+    uint32_t head = fanout_head(fanout);
+    uint32_t offset = pos & fanout->mask;
+    size_t n = head - pos;
+
+    if (n == 0 || fanout_overrun(fanout, pos))
+    {
+        return 0;
+    }
+
+    if (n > fanout->mask + 1 - offset)
+    {
+        n = fanout->mask + 1 - offset;
+    }
+
+    *data = fanout->buffer + offset;
+    return n;
+}
+
+// copy out bytes at pos, crossing the end of the ring if needed
+size_t fanout_copy(const fanout_t *fanout, uint32_t pos, uint8_t *data, size_t len)
+{
+    size_t copied = 0;
+    const uint8_t *p;
+    size_t n;
+
+    while (copied < len && (n = fanout_peek(fanout, pos + copied, &p)) > 0)
+    {
+        if (n > len - copied)
+        {
+            n = len - copied;
+        }
+        memcpy(data + copied, p, n);
+        copied += n;
+    }
+
+    return copied;
+}
+
+// true if the data at pos has been (or is being) overwritten by the producer,
+// readers check again after using in-place data
+bool fanout_overrun(const fanout_t *fanout, uint32_t pos)
+{
+    // the fence keeps the reads of the data before the load of reserve
+    atomic_thread_fence(memory_order_acquire);
+    uint32_t reserve = atomic_load_explicit(&fanout->reserve, memory_order_relaxed);
+    return (uint32_t)(reserve - pos) > fanout->mask + 1;
+}
+
+bool fanout_subscribe(fanout_t *fanout, fanout_notify_t notify, void *arg)
+{
+    for (int i = 0; i < FANOUT_SUBSCRIBER_MAX; i++)
+    {
+        if (atomic_load_explicit(&fanout->subscribers[i].notify, memory_order_relaxed) == NULL)
+        {
+            fanout->subscribers[i].arg = arg;
+            atomic_store_explicit(&fanout->subscribers[i].notify, notify, memory_order_release);
+            return true;
+        }
+    }
+    return false;
+}
+
+void fanout_unsubscribe(fanout_t *fanout, fanout_notify_t notify, void *arg)
+{
+    for (int i = 0; i < FANOUT_SUBSCRIBER_MAX; i++)
+    {
+        if (atomic_load_explicit(&fanout->subscribers[i].notify, memory_order_relaxed) == notify &&
+            fanout->subscribers[i].arg == arg)
+        {
+            atomic_store_explicit(&fanout->subscribers[i].notify, NULL, memory_order_release);
+        }
+    }
+}
@@ -29,6 +29,8 @@
 #include "ntrip_client.h"
 #include "battery.h"
 #include "sdcard.h"
+#include "udp_output.h"
+#include "ntrip_server.h"
 
 static const char *TAG = "MAIN";
 
@@ -63,10 +65,16 @@ void app_main()
     // start NTRIP Caster
     ntrip_caster_init();
 
+    // start UDP output to LAN rovers
+    udp_output_init();
+
     // wait for internet
     wait_for_ip();
     ping(config_get(CONFIG_NTRIP_IP));
 
     // init ntrip client
     ntrip_client_init();
+
+    // push corrections to a remote caster
+    ntrip_server_init();
 }
@@ -0,0 +1,141 @@
+/*
+ * This file is part of the ESP32-GNSS-Base-Station firmware, published
+ * at (https://github.com/vuquangtrong/esp32-gnss-base-station).
+ * Copyright (c) 2023 Vu Quang Trong.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "nmea.h"
+
+static int nmea_hex(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    return -1;
+}
+
+// $<data>*<2 hex digits>, checksum is the XOR of all chars between $ and *
+bool nmea_check_checksum(const char *sentence, size_t len)
+{
+    if (len < 4 || sentence[0] != '$' || sentence[len - 3] != '*')
+    {
+        return false;
+    }
+
+    uint8_t checksum = 0;
+    for (size_t i = 1; i < len - 3; i++)
+    {
+        checksum ^= (uint8_t)sentence[i];
+    }
+
+    int hi = nmea_hex(sentence[len - 2]);
+    int lo = nmea_hex(sentence[len - 1]);
+    return hi >= 0 && lo >= 0 && checksum == ((hi << 4) | lo);
+}
+
+void nmea_parser_init(nmea_parser_t *parser)
+{
+    memset(parser, 0, sizeof(nmea_parser_t));
+}
+
+static size_t nmea_parser_complete(nmea_parser_t *parser, nmea_sentence_cb_t cb, void *ctx)
+{
+    size_t len = parser->len;
+    parser->len = 0;
+
+    // strip CR
+    if (len > 0 && parser->line[len - 1] == '\r')
+    {
+        len--;
+    }
+    parser->line[len] = '\0';
+
+    if (!nmea_check_checksum(parser->line, len))
+    {
+        parser->checksum_errors++;
+        return 0;
+    }
+
+    if (cb)
+    {
+        cb(parser->line, len, ctx);
+    }
+    return 1;
+}
+
+// feed a chunk of the stream, return the number of emitted sentences
+size_t nmea_parser_feed(nmea_parser_t *parser, const uint8_t *data, size_t len, nmea_sentence_cb_t cb, void *ctx)
+{
+    size_t sentences = 0;
+
+    while (len > 0)
+    {
+        // look for the start of a sentence
+        if (parser->len == 0)
+        {
+            const uint8_t *start = memchr(data, '$', len);
+            if (start == NULL)
+            {
+                break;
+            }
+            len -= start - data;
+            data = start;
+        }
+
+        // take everything up to the end of line
+        const uint8_t *end = memchr(data, '\n', len);
+        size_t n = end ? (size_t)(end - data) : len;
+
+        // a new '$' inside the segment restarts the sentence
+        size_t from = parser->len == 0 ? 1 : 0;
+        const uint8_t *restart = n > from ? memchr(data + from, '$', n - from) : NULL;
+        if (restart != NULL)
+        {
+            parser->len = 0;
+            len -= restart - data;
+            data = restart;
+            continue;
+        }
+
+        if (parser->len + n >= NMEA_LEN_MAX)
+        {
+            // too long, it is not a sentence
+            parser->overflows++;
+            parser->len = 0;
+            data += n;
+            len -= n;
+            continue;
+        }
+
+        memcpy(parser->line + parser->len, data, n);
+        parser->len += n;
+        data += n;
+        len -= n;
+
+        if (end != NULL)
+        {
+            sentences += nmea_parser_complete(parser, cb, ctx);
+            data++; // skip LF
+            len--;
+        }
+    }
+
+    return sentences;
+}
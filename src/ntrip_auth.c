@@ -0,0 +1,216 @@
+/*
+ * This file is part of the ESP32-GNSS-Base-Station firmware, published
+ * at (https://github.com/vuquangtrong/esp32-gnss-base-station).
+ * Copyright (c) 2023 Vu Quang Trong.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <freertos/FreeRTOS.h>
+#include <mbedtls/base64.h>
+
+#include "util.h"
+#include "config.h"
+#include "ntrip_auth.h"
+
+#define AUTH_USERS_MAX 8
+#define AUTH_TABLE_SIZE 16 // power of 2, twice the users to keep probing short
+#define AUTH_CREDENTIAL_LEN 64
+#define AUTH_MOUNT_LEN 16
+#define AUTH_ALL_MOUNTS "*"
+
+static const char *TAG = "NTRIP_AUTH";
+
+/*
+ * users are kept by their base64 "user:password" credential, as sent in
+ * the Authorization header, so a connection is checked without decoding
+ */
+struct ntrip_auth_user_t
+{
+    char credential[AUTH_CREDENTIAL_LEN]; // empty for a free slot
+    char mount[AUTH_MOUNT_LEN];           // or "*" for all mounts
+    uint8_t limit;                        // concurrent connections, 0 for no limit
+    uint8_t active;
+};
+
+static ntrip_auth_user_t auth_table[AUTH_TABLE_SIZE];
+static size_t auth_count = 0;
+static portMUX_TYPE auth_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// FNV-1a
+static uint32_t ntrip_auth_hash(const char *s)
+{
+    uint32_t hash = 2166136261u;
+    while (*s)
+    {
+        hash = (hash ^ (uint8_t)*s++) * 16777619u;
+    }
+    return hash;
+}
+
+static bool ntrip_auth_mount_match(const ntrip_auth_user_t *user, const char *mount)
+{
+    return strcmp(user->mount, AUTH_ALL_MOUNTS) == 0 || strcmp(user->mount, mount) == 0;
+}
+
+static ntrip_auth_user_t *ntrip_auth_find(const char *credential, const char *mount)
+{
+    for (uint32_t i = ntrip_auth_hash(credential), n = 0; n < AUTH_TABLE_SIZE; i++, n++)
+    {
+        ntrip_auth_user_t *user = &auth_table[i & (AUTH_TABLE_SIZE - 1)];
+        if (user->credential[0] == '\0')
+        {
+            return NULL;
+        }
+        if (strcmp(user->credential, credential) == 0 && ntrip_auth_mount_match(user, mount))
+        {
+            return user;
+        }
+    }
+    return NULL;
+}
+
+static esp_err_t ntrip_auth_add(const char *mount, const char *name, const char *password, int limit)
+{
+    char plain[AUTH_CREDENTIAL_LEN];
+    char credential[AUTH_CREDENTIAL_LEN];
+    size_t len;
+
+    ERROR_IF(auth_count == AUTH_USERS_MAX,
+             return ESP_ERR_NO_MEM,
+             "No room for user %s", name);
+    ERROR_IF(strlen(mount) >= AUTH_MOUNT_LEN,
+             return ESP_ERR_INVALID_ARG,
+             "Invalid mount %s", mount);
+
+    // stay within the credential size after base64 encoding
+    len = snprintf(plain, sizeof(plain), "%s:%s", name, password);
+    ERROR_IF(len >= (AUTH_CREDENTIAL_LEN - 1) / 4 * 3,
+             return ESP_ERR_INVALID_SIZE,
+             "Credential of %s is too long", name);
+    mbedtls_base64_encode((unsigned char *)credential, sizeof(credential), &len, (unsigned char *)plain, len);
+    credential[len] = '\0';
+
+    uint32_t i = ntrip_auth_hash(credential);
+    while (auth_table[i & (AUTH_TABLE_SIZE - 1)].credential[0] != '\0')
+    {
+        i++;
+    }
+
+    ntrip_auth_user_t *user = &auth_table[i & (AUTH_TABLE_SIZE - 1)];
+    strcpy(user->credential, credential);
+    strcpy(user->mount, mount);
+    user->limit = MIN(MAX(limit, 0), UINT8_MAX);
+    user->active = 0;
+    auth_count++;
+
+    ESP_LOGI(TAG, "user %s on %s, limit %d", name, mount, limit);
+    return ESP_OK;
+}
+
+// users are set as "MOUNT:user:password[:limit] ...", MOUNT is * for all mounts
+esp_err_t ntrip_auth_init()
+{
+    char users[CONFIG_LEN_MAX];
+    char *saveptr;
+
+    memset(auth_table, 0, sizeof(auth_table));
+    auth_count = 0;
+
+    strcpy(users, config_get(CONFIG_CASTER_USERS));
+    for (char *item = strtok_r(users, " ", &saveptr); item; item = strtok_r(NULL, " ", &saveptr))
+    {
+        char *fields[4] = {item, NULL, NULL, NULL};
+        for (int i = 1; i < 4 && fields[i - 1]; i++)
+        {
+            fields[i] = strchr(fields[i - 1], ':');
+            if (fields[i])
+            {
+                *fields[i]++ = '\0';
+            }
+        }
+
+        ERROR_IF(fields[2] == NULL,
+                 continue,
+                 "Invalid user of mount %s", item);
+
+        ntrip_auth_add(fields[0], fields[1], fields[2], fields[3] ? atoi(fields[3]) : 0);
+    }
+
+    return ESP_OK;
+}
+
+bool ntrip_auth_required(const char *mount)
+{
+    for (size_t i = 0; i < AUTH_TABLE_SIZE; i++)
+    {
+        if (auth_table[i].credential[0] != '\0' && ntrip_auth_mount_match(&auth_table[i], mount))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * check the Authorization header value of a connection to a mount,
+ * return ESP_ERR_NOT_FOUND for an unknown user,
+ * ESP_ERR_INVALID_STATE if the user has reached the connection limit,
+ * a granted user has to be released when the connection is closed
+ */
+esp_err_t ntrip_auth_acquire(const char *mount, const char *authorization, ntrip_auth_user_t **user)
+{
+    if (strncasecmp(authorization, "Basic ", 6) != 0)
+    {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    *user = ntrip_auth_find(authorization + 6, mount);
+    if (*user == NULL)
+    {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    esp_err_t err = ESP_OK;
+    portENTER_CRITICAL(&auth_lock);
+    if ((*user)->limit && (*user)->active >= (*user)->limit)
+    {
+        err = ESP_ERR_INVALID_STATE;
+    }
+    else
+    {
+        (*user)->active++;
+    }
+    portEXIT_CRITICAL(&auth_lock);
+
+    if (err != ESP_OK)
+    {
+        *user = NULL;
+    }
+    return err;
+}
+
+void ntrip_auth_release(ntrip_auth_user_t *user)
+{
+    if (user == NULL)
+    {
+        return;
+    }
+
+    portENTER_CRITICAL(&auth_lock);
+    user->active--;
+    portEXIT_CRITICAL(&auth_lock);
+}
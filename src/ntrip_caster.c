@@ -16,131 +16,1767 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <errno.h>
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <stddef.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
-#include <sys/queue.h>
+#include <unistd.h>
+#include <sys/select.h>
 #include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include <esp_http_server.h>
+#include <esp_timer.h>
+#include <esp_vfs_eventfd.h>
 
 #include "util.h"
+#include "config.h"
 #include "status.h"
 #include "uart.h"
+#include "fanout.h"
+#include "rtcm3.h"
+#include "ntrip_auth.h"
 #include "ntrip_caster.h"
 
+// the ACK time reads the TCP control block of lwIP, a private structure, only on the IDF it was checked with
+#ifdef NTRIP_CASTER_MEASURE_ACK
+#include <esp_idf_version.h>
+#if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 0, 0) || ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 5, 0)
+#error "NTRIP_CASTER_MEASURE_ACK is not checked with this IDF version, see struct lwip_sock and struct tcp_pcb"
+#endif
+#include <lwip/priv/sockets_priv.h>
+#include <lwip/priv/tcpip_priv.h>
+#include <lwip/api.h>
+#include <lwip/tcp.h>
+#endif
+
+#define KEEP_ALIVE_MS 500
+#define RETRY_MS 20
+#define CLIENT_QUEUE_DEFAULT 4096
+#define CLIENT_QUEUE_MAX 12288 // must stay below the shared buffer size
+#define CLIENT_MAX 24
+#define MOUNT_MAX 4
+#define MOUNT_NAME_LEN 16
+#define MOUNT_FANOUT_LEN 16384
+#define MOUNT_TYPES_MAX 24
+#define MOUNT_DETAILS_LEN 256
+#define MOUNT_SYSTEMS_LEN 32
+#define EPOCH_GAP_MS 100 // frames of one type closer than this belong to the same epoch
+#define COALESCE_GAP_MS 20 // frames held after an epoch go out when the stream is quiet this long
+#define COALESCE_TIMEOUT_MS 200 // held frames go out at the latest after this, e.g. when the last MSM is lost
+#define CLIENT_WRITE_LEN 5840 // data of one write to a client, 4 full TCP segments
+#define EPOCH_SYSTEMS 7 // MSM constellations, by tens from 1071
+#define POLL_MS 10 // paced clients, and clients waiting for an ACK when measuring, are served at this interval
+#define PACING_BURST 1460 // token bucket depth, one TCP segment
+#define PACING_RATE_MIN 1000 // bytes per second
+#define RATE_SLOT_MS 100 // send rate is measured per slot
+#define RATE_WINDOW_SLOTS 100 // peak and average are published over this many slots
+#define TYPE_EXPIRE_MS 30000
+#define TABLE_LEN_MAX 2048
+#define POSITION_LEN 32
+#define FRAMING_LEN 12 // chunk trailer and header, or a keep-alive chunk
+#define AUTHORIZATION_LEN 80
+#define RECV_LEN 128
+#define QUERY_LEN 128
+#define CACHE_FRAME_LEN 128 // longest station frame kept for new clients
+
 static const char *TAG = "NTRIP_CASTER";
 
-typedef struct ntrip_caster_client_t
+typedef enum
+{
+    CLIENT_POLICY_DROP_OLDEST = 0,
+    CLIENT_POLICY_DISCONNECT
+} ntrip_caster_client_policy_t;
+
+// latency profile of a mount, set in cas_latency
+typedef enum
+{
+    MOUNT_PROFILE_DEFAULT = 0,
+    MOUNT_PROFILE_LOW_LATENCY, // no Nagle, frames go out as soon as their epoch is complete
+    MOUNT_PROFILE_THROUGHPUT   // Nagle and MSG_MORE, an epoch and the frames after it in one write
+} ntrip_caster_mount_profile_t;
+
+static const char *const MOUNT_PROFILE_NAMES[] = {"default", "low", "throughput"};
+
+/*
+ * client slots go FREE -> CLAIMED by the HTTP handler, -> ACTIVE when httpd
+ * has released the socket, -> FREE again when the caster task removes it,
+ * so each state has one writer and the caster task never waits on a lock
+ */
+typedef enum
+{
+    CLIENT_FREE = 0,
+    CLIENT_CLAIMED,
+    CLIENT_ACTIVE
+} ntrip_caster_client_state_t;
+
+/*
+ * each client reads the shared RTCM3 buffer at its own position,
+ * bytes between pos and the buffer head are its outgoing queue,
+ * after the NTRIP handshake the socket is owned by the caster task, not by httpd
+ */
+typedef struct ntrip_caster_client_t
+{
+    _Atomic uint8_t state;
+    struct ntrip_caster_mount_t *mount; // first field cleared when the slot is claimed
+    ntrip_auth_user_t *user; // NULL on a mount without users
+    int socket;
+    uint32_t pace_rate;   // token rate in bytes per second, set on each epoch to spread it over the pacing window
+    int32_t pace_tokens;  // bytes which can be sent now
+    uint32_t pace_ms;     // last token refill
+    size_t pace_queued;   // queued bytes after the last send, the queue grows when an epoch is released
+    uint32_t pace_epoch;  // epoch start of the mount when the rate was set
+    uint32_t measure_release; // mount release when the queue last emptied, one sample per release
+    uint32_t ack_seq;         // TCP sequence after the sampled data
+    uint32_t ack_us;          // when the sampled data was written
+    bool ack_wait;
+    uint32_t sent_ms; // last write, a keep-alive goes out after KEEP_ALIVE_MS without one
+    uint32_t pos;       // next byte to send
+    uint32_t frame_end; // end of the frame being sent, pos == frame_end between frames
+    uint32_t skip_to;   // where to continue after frame_end, frames in between are dropped
+    size_t queue_max;
+    ntrip_caster_client_policy_t policy;
+    bool chunked;                // NTRIP v2, each frame is sent as one HTTP chunk
+    bool chunk_open;             // the chunk of the frame ending at frame_end is not terminated yet
+    char framing[FRAMING_LEN];   // chunk framing bytes to send before any frame data
+    uint8_t framing_len;
+    uint32_t dropped_frames;
+    uint32_t dropped_bytes;
+    rtcm3_filter_t filter; // message types asked in the URL query, empty for all
+    uint32_t filter_pos;   // frames before this one are decided, a frame at pos < filter_pos passed
+} ntrip_caster_client_t;
+
+// station messages which a rover needs before it can use the observations
+static const uint16_t CACHE_TYPES[] = {1005, 1006, 1007, 1033, 1230};
+#define CACHE_TYPES_COUNT (sizeof(CACHE_TYPES) / sizeof(CACHE_TYPES[0]))
+
+// a message type seen on a mount, and its period in whole seconds, 0 if not known yet
+typedef struct ntrip_caster_msg_t
+{
+    uint16_t type;
+    uint16_t period;
+    uint32_t last_ms;
+} ntrip_caster_msg_t;
+
+/*
+ * a mountpoint serves the frames of its fanout to its own clients,
+ * a filtered mount copies the frames it keeps from its parent mount
+ * into its own fanout, so clients of all mounts are served the same way
+ */
+typedef struct ntrip_caster_mount_t
+{
+    char name[MOUNT_NAME_LEN];
+    fanout_t *fanout;
+    struct ntrip_caster_mount_t *parent; // NULL for a source mount
+    uint32_t parent_pos;                 // next frame to filter in the parent fanout
+    rtcm3_filter_t filter;
+    bool auth;         // only users of this mount can connect
+    uint32_t head;     // fanout head at the last sending round
+    uint32_t scan_pos; // next frame to count in the message statistics
+    ntrip_caster_msg_t msgs[MOUNT_TYPES_MAX]; // sorted by type
+    size_t msg_count;
+    char details[MOUNT_DETAILS_LEN]; // "type(period),..." for the sourcetable
+    char systems[MOUNT_SYSTEMS_LEN]; // constellations of the MSM types
+    uint64_t bytes_in;               // written to the mount fanout
+    uint64_t bytes_out;              // sent to all clients of the mount
+    uint32_t rate_slot;              // current send rate slot, in RATE_SLOT_MS since boot
+    uint32_t rate_slot_bytes;        // sent in the current slot
+    uint32_t rate_window_slots;      // slots in the current window
+    uint32_t rate_window_bytes;      // sent in the current window
+    uint32_t rate_window_peak;       // largest slot of the current window
+    uint32_t rate_peak;              // largest slot of the last window, in bytes
+    uint32_t rate_avg;               // average slot of the last window, in bytes
+    uint64_t rate_window_in;         // bytes_in at the start of the current window
+    uint32_t bitrate;                // stream rate of the last window, in bits/s for the sourcetable
+    uint8_t cache[CACHE_TYPES_COUNT][CACHE_FRAME_LEN]; // latest frame of each station type
+    uint16_t cache_len[CACHE_TYPES_COUNT];             // 0 if not seen yet
+    uint32_t epoch_next;  // first MSM of the epoch being scanned
+    uint32_t epoch_start; // first MSM of the last complete epoch, still in the fanout
+    uint32_t epoch_time[EPOCH_SYSTEMS]; // MSM time of each constellation in the epoch being scanned
+    uint8_t epoch_systems;              // constellations seen in the epoch being scanned
+    bool epoch_open;
+    bool epoch_valid;
+    _Atomic uint32_t release; // clients are sent the frames up to here, the rest is held until its epoch is complete, httpd reads it for new clients
+    uint32_t held_ms;  // when the oldest held frame was scanned
+    uint32_t quiet_ms; // when the last frame was scanned
+    ntrip_caster_mount_profile_t profile;
+    _Atomic uint32_t publish_us; // when the source last wrote to the fanout, only when measuring
+    uint32_t release_us;         // publish time of the data released last
+    uint32_t latency_samples;    // source to socket
+    uint64_t latency_sum_us;
+    uint32_t latency_max_us;
+    uint32_t ack_samples; // socket to ACK
+    uint64_t ack_sum_us;
+    uint32_t ack_max_us;
+} ntrip_caster_mount_t;
+
+static ntrip_caster_client_t clients[CLIENT_MAX];
+
+// mounts are only appended, an entry is complete before it is counted
+static ntrip_caster_mount_t mounts[MOUNT_MAX];
+static _Atomic size_t mount_count = 0;
+static portMUX_TYPE cache_lock = portMUX_INITIALIZER_UNLOCKED; // station frames and last epoch of all mounts
+static int wake_fd = -1; // eventfd which wakes the caster task out of select()
+
+// the caster task stages the data of a client here, then sends it in one write
+static uint8_t *write_buffer = NULL;
+static size_t write_len = 0;
+static size_t write_budget = 0;
+
+static uint32_t pacing_window_ms = 0; // 0 to send each epoch at once
+static bool measure = false;          // latency samples of all mounts, set in cas_measure
+
+// the sourcetable is cached and built again only when its inputs change
+static portMUX_TYPE table_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t table_version = 1; // changed with the message statistics of any mount
+static uint32_t table_cache_version = 0;
+static char table_cache_position[POSITION_LEN];
+static char *table_cache = NULL;
+static size_t table_cache_len = 0;
+
+#define TABLE_HEADER \
+    "SOURCETABLE 200 OK" CARRET NEWLINE \
+    "Content-Type: text/plain" CARRET NEWLINE \
+    "Content-Length: %u" CARRET NEWLINE \
+        CARRET NEWLINE
+
+// country is cas_country, bitrate is the stream rate of the last RATE_WINDOW_SLOTS window
+#define TABLE_STREAM \
+    "STR;%s;%s;RTCM 3;%s;2;%s;GNSS;%s;%s;0;0;GNSS;none;%c;N;%" PRIu32 ";" CARRET NEWLINE
+
+// MSM message types 1071-1127, by tens
+static const char *MSM_SYSTEMS[] = {"GPS", "GLO", "GAL", "SBAS", "QZSS", "BDS"};
+
+static char TABLE_END[] =
+    "ENDSOURCETABLE" CARRET NEWLINE;
+
+static char STREAM_RESPONSE[] =
+    "ICY 200 OK" CARRET NEWLINE;
+
+static char STREAM_RESPONSE_V2[] =
+    "HTTP/1.1 200 OK" CARRET NEWLINE
+    "Ntrip-Version: Ntrip/2.0" CARRET NEWLINE
+    "Server: NTRIP GNSS/1.0" CARRET NEWLINE
+    "Content-Type: gnss/data" CARRET NEWLINE
+    "Cache-Control: no-store, no-cache, max-age=0" CARRET NEWLINE
+    "Transfer-Encoding: chunked" CARRET NEWLINE
+    "Connection: close" CARRET NEWLINE
+        CARRET NEWLINE;
+
+static char UNAUTHORIZED_RESPONSE[] =
+    "HTTP/1.0 401 Unauthorized" CARRET NEWLINE
+    "WWW-Authenticate: Basic realm=\"NTRIP\"" CARRET NEWLINE
+    "Content-Length: 0" CARRET NEWLINE
+        CARRET NEWLINE;
+
+static char FORBIDDEN_RESPONSE[] =
+    "HTTP/1.0 403 Forbidden" CARRET NEWLINE
+    "Content-Length: 0" CARRET NEWLINE
+        CARRET NEWLINE;
+
+static char BAD_REQUEST_RESPONSE[] =
+    "HTTP/1.0 400 Bad Request" CARRET NEWLINE
+    "Content-Length: 0" CARRET NEWLINE
+        CARRET NEWLINE;
+
+static char UNAVAILABLE_RESPONSE[] =
+    "HTTP/1.0 503 Service Unavailable" CARRET NEWLINE
+    "Content-Length: 0" CARRET NEWLINE
+        CARRET NEWLINE;
+
+static char KEEP_ALIVE_CHUNK[] =
+    "4" CARRET NEWLINE
+    "GNSS" CARRET NEWLINE;
+
+static _Atomic int client_count = 0;
+
+// list the seen types with their periods, and the constellations of the MSM types
+static void ntrip_caster_mount_describe(ntrip_caster_mount_t *mount)
+{
+    char details[MOUNT_DETAILS_LEN] = "";
+    char systems[MOUNT_SYSTEMS_LEN] = "";
+    bool system_seen[sizeof(MSM_SYSTEMS) / sizeof(MSM_SYSTEMS[0])] = {false};
+    size_t n = 0;
+
+    for (size_t i = 0; i < mount->msg_count && n < sizeof(details); i++)
+    {
+        ntrip_caster_msg_t *msg = &mount->msgs[i];
+        n += snprintf(details + n, sizeof(details) - n, msg->period ? "%s%u(%u)" : "%s%u",
+                      i ? "," : "", msg->type, msg->period);
+
+        if (msg->type >= 1071 && msg->type <= 1127 && msg->type % 10 != 0 && msg->type % 10 <= 7)
+        {
+            system_seen[(msg->type - 1071) / 10] = true;
+        }
+    }
+
+    n = 0;
+    for (size_t i = 0; i < sizeof(MSM_SYSTEMS) / sizeof(MSM_SYSTEMS[0]); i++)
+    {
+        if (system_seen[i])
+        {
+            n += snprintf(systems + n, sizeof(systems) - n, "%s%s", n ? "+" : "", MSM_SYSTEMS[i]);
+        }
+    }
+
+    portENTER_CRITICAL(&table_lock);
+    memcpy(mount->details, details, sizeof(details));
+    memcpy(mount->systems, systems, sizeof(systems));
+    table_version++;
+    portEXIT_CRITICAL(&table_lock);
+}
+
+// record a frame, return true if the list of types or periods changed
+static bool ntrip_caster_mount_seen(ntrip_caster_mount_t *mount, uint16_t type, uint32_t now)
+{
+    size_t i = 0;
+    while (i < mount->msg_count && mount->msgs[i].type < type)
+    {
+        i++;
+    }
+
+    if (i == mount->msg_count || mount->msgs[i].type != type)
+    {
+        if (mount->msg_count == MOUNT_TYPES_MAX)
+        {
+            return false;
+        }
+        memmove(&mount->msgs[i + 1], &mount->msgs[i], (mount->msg_count - i) * sizeof(ntrip_caster_msg_t));
+        mount->msgs[i] = (ntrip_caster_msg_t){.type = type, .period = 0, .last_ms = now};
+        mount->msg_count++;
+        return true;
+    }
+
+    ntrip_caster_msg_t *msg = &mount->msgs[i];
+    uint32_t interval = now - msg->last_ms;
+    if (interval < EPOCH_GAP_MS)
+    {
+        return false;
+    }
+    msg->last_ms = now;
+
+    uint16_t period = MAX((interval + 500) / 1000, 1);
+    if (period == msg->period)
+    {
+        return false;
+    }
+    msg->period = period;
+    return true;
+}
+
+// forget the types which are not sent anymore
+static bool ntrip_caster_mount_expire(ntrip_caster_mount_t *mount, uint32_t now)
+{
+    bool changed = false;
+    size_t n = 0;
+
+    for (size_t i = 0; i < mount->msg_count; i++)
+    {
+        ntrip_caster_msg_t *msg = &mount->msgs[i];
+        if (now - msg->last_ms > MAX(msg->period * 3000, TYPE_EXPIRE_MS))
+        {
+            changed = true;
+            continue;
+        }
+        mount->msgs[n++] = *msg;
+    }
+
+    mount->msg_count = n;
+    return changed;
+}
+
+/*
+ * assemble epochs: frames are held while an epoch is open, and released up to
+ * the MSM without the multiple message bit, or up to an MSM of a newer epoch if
+ * that one is lost, so clients get each epoch in one write,
+ * MSM times are only compared within a constellation, as each one has its own time scale,
+ * the start of the last complete epoch is also kept for new clients
+ */
+static void ntrip_caster_mount_epoch(ntrip_caster_mount_t *mount, size_t len, uint32_t now)
+{
+    uint8_t msm[RTCM3_HEADER_LEN + 7];
+
+    if (mount->release == mount->scan_pos)
+    {
+        mount->held_ms = now;
+    }
+    mount->quiet_ms = now;
+
+    if (fanout_copy(mount->fanout, mount->scan_pos, msm, sizeof(msm)) != sizeof(msm) ||
+        !rtcm3_msm(rtcm3_msg_type(msm)))
+    {
+        return;
+    }
+
+    uint32_t time = rtcm3_msm_epoch(msm);
+    uint8_t system = (rtcm3_msg_type(msm) - 1071) / 10;
+    if (mount->epoch_open && (mount->epoch_systems & (1 << system)) && time != mount->epoch_time[system])
+    {
+        mount->release = mount->scan_pos;
+        mount->held_ms = now;
+        mount->epoch_open = false;
+    }
+
+    if (!mount->epoch_open)
+    {
+        mount->epoch_open = true;
+        mount->epoch_systems = 0;
+        mount->epoch_next = mount->scan_pos;
+    }
+    mount->epoch_systems |= 1 << system;
+    mount->epoch_time[system] = time;
+
+    // a throughput mount waits for the frames after the epoch too
+    if (!rtcm3_msm_multiple(msm))
+    {
+        mount->epoch_open = false;
+        if (mount->profile != MOUNT_PROFILE_THROUGHPUT)
+        {
+            mount->release = mount->scan_pos + len;
+        }
+        portENTER_CRITICAL(&cache_lock);
+        mount->epoch_start = mount->epoch_next;
+        mount->epoch_valid = true;
+        portEXIT_CRITICAL(&cache_lock);
+    }
+}
+
+// release the held frames when the stream is quiet after an epoch, at once on a low latency mount,
+// or when they are too old
+static void ntrip_caster_mount_release(ntrip_caster_mount_t *mount)
+{
+    uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+
+    if (mount->release == mount->scan_pos)
+    {
+        return;
+    }
+
+    bool quiet = mount->profile == MOUNT_PROFILE_LOW_LATENCY || now - mount->quiet_ms >= COALESCE_GAP_MS;
+    if ((!mount->epoch_open && quiet) ||
+        now - mount->held_ms >= COALESCE_TIMEOUT_MS)
+    {
+        mount->release = mount->scan_pos;
+        mount->epoch_open = false;
+    }
+}
+
+// count the bytes sent per RATE_SLOT_MS slot, then publish the peak and average slot of each window
+static void ntrip_caster_mount_rate(ntrip_caster_mount_t *mount)
+{
+    uint32_t slot = xTaskGetTickCount() * portTICK_PERIOD_MS / RATE_SLOT_MS;
+    if (slot == mount->rate_slot)
+    {
+        return;
+    }
+
+    // close the current slot, the slots since then were silent
+    mount->rate_window_peak = MAX(mount->rate_window_peak, mount->rate_slot_bytes);
+    mount->rate_window_bytes += mount->rate_slot_bytes;
+    mount->rate_window_slots += MIN(slot - mount->rate_slot, RATE_WINDOW_SLOTS);
+    mount->rate_slot_bytes = 0;
+    mount->rate_slot = slot;
+
+    if (mount->rate_window_slots >= RATE_WINDOW_SLOTS)
+    {
+        mount->rate_peak = mount->rate_window_peak;
+        mount->rate_avg = mount->rate_window_bytes / mount->rate_window_slots;
+
+        uint32_t bitrate = (mount->bytes_in - mount->rate_window_in) * 8 * 1000 / (mount->rate_window_slots * RATE_SLOT_MS);
+        mount->rate_window_in = mount->bytes_in;
+        if (bitrate != mount->bitrate)
+        {
+            portENTER_CRITICAL(&table_lock);
+            mount->bitrate = bitrate;
+            table_version++;
+            portEXIT_CRITICAL(&table_lock);
+        }
+        mount->rate_window_peak = 0;
+        mount->rate_window_bytes = 0;
+        mount->rate_window_slots = 0;
+    }
+}
+
+// keep the latest station frames, which new clients get before the live stream
+static void ntrip_caster_mount_cache(ntrip_caster_mount_t *mount, const uint8_t *header)
+{
+    uint16_t type = rtcm3_msg_type(header);
+    size_t len = rtcm3_frame_len(header);
+
+    for (size_t i = 0; i < CACHE_TYPES_COUNT; i++)
+    {
+        if (CACHE_TYPES[i] == type && len <= CACHE_FRAME_LEN)
+        {
+            portENTER_CRITICAL(&cache_lock);
+            fanout_copy(mount->fanout, mount->scan_pos, mount->cache[i], len);
+            mount->cache_len[i] = fanout_overrun(mount->fanout, mount->scan_pos) ? 0 : len;
+            portEXIT_CRITICAL(&cache_lock);
+            return;
+        }
+    }
+}
+
+// count the message types of the frames sent since the last round
+static void ntrip_caster_mount_scan(ntrip_caster_mount_t *mount)
+{
+    uint8_t header[RTCM3_HEADER_LEN + 2];
+    uint32_t head = fanout_head(mount->fanout);
+    uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    bool changed = false;
+
+    while (mount->scan_pos != head)
+    {
+        if (fanout_copy(mount->fanout, mount->scan_pos, header, sizeof(header)) != sizeof(header) ||
+            fanout_overrun(mount->fanout, mount->scan_pos))
+        {
+            mount->scan_pos = mount->release = head;
+            mount->epoch_open = false;
+            break;
+        }
+
+        size_t len = rtcm3_frame_len(header);
+        changed |= ntrip_caster_mount_seen(mount, rtcm3_msg_type(header), now);
+        ntrip_caster_mount_epoch(mount, len, now);
+        ntrip_caster_mount_cache(mount, header);
+        mount->scan_pos += len;
+    }
+
+    changed |= ntrip_caster_mount_expire(mount, now);
+    if (changed)
+    {
+        ntrip_caster_mount_describe(mount);
+    }
+}
+
+static ntrip_caster_mount_t *ntrip_caster_mount_find(const char *name, size_t len)
+{
+    for (size_t i = 0; i < mount_count; i++)
+    {
+        if (strlen(mounts[i].name) == len && strncmp(mounts[i].name, name, len) == 0)
+        {
+            return &mounts[i];
+        }
+    }
+    return NULL;
+}
+
+// latency profiles are set as "NAME=low NAME=throughput ...", other mounts use the default one
+static ntrip_caster_mount_profile_t ntrip_caster_mount_profile(const char *name)
+{
+    char profiles_config[CONFIG_LEN_MAX];
+    char *saveptr;
+
+    strcpy(profiles_config, config_get(CONFIG_CASTER_LATENCY));
+    for (char *item = strtok_r(profiles_config, " ", &saveptr); item; item = strtok_r(NULL, " ", &saveptr))
+    {
+        char *profile = strchr(item, '=');
+        if (profile == NULL || strncmp(item, name, profile - item) != 0 || name[profile - item] != '\0')
+        {
+            continue;
+        }
+
+        for (size_t i = 0; i < sizeof(MOUNT_PROFILE_NAMES) / sizeof(MOUNT_PROFILE_NAMES[0]); i++)
+        {
+            if (strcmp(profile + 1, MOUNT_PROFILE_NAMES[i]) == 0)
+            {
+                return i;
+            }
+        }
+        ESP_LOGW(TAG, "Invalid profile %s of mount %s", profile + 1, name);
+    }
+    return MOUNT_PROFILE_DEFAULT;
+}
+
+static ntrip_caster_mount_t *ntrip_caster_mount_new(const char *name)
+{
+    ERROR_IF(mount_count == MOUNT_MAX,
+             return NULL,
+             "No room for mount %s", name);
+    ERROR_IF(strlen(name) == 0 || strlen(name) >= MOUNT_NAME_LEN,
+             return NULL,
+             "Invalid mount name %s", name);
+    ERROR_IF(ntrip_caster_mount_find(name, strlen(name)) != NULL,
+             return NULL,
+             "Duplicated mount %s", name);
+
+    ntrip_caster_mount_t *mount = &mounts[mount_count];
+    memset(mount, 0, sizeof(ntrip_caster_mount_t));
+    strcpy(mount->name, name);
+    mount->auth = ntrip_auth_required(name);
+    mount->profile = ntrip_caster_mount_profile(name);
+    return mount;
+}
+
+// wake the caster task, called by the fanout producers with their mount, and the HTTP handlers
+static void ntrip_caster_notify(void *arg)
+{
+    ntrip_caster_mount_t *mount = arg;
+    if (mount && measure)
+    {
+        mount->publish_us = esp_timer_get_time();
+    }
+
+    uint64_t count = 1;
+    write(wake_fd, &count, sizeof(count));
+}
+
+// serve the frames of an existing mount which pass the filter
+static esp_err_t ntrip_caster_mount_add_filtered(const char *name, const char *parent, const char *filter)
+{
+    ntrip_caster_mount_t *source = ntrip_caster_mount_find(parent, strlen(parent));
+    ERROR_IF(source == NULL,
+             return ESP_FAIL,
+             "Unknown source %s of mount %s", parent, name);
+
+    ntrip_caster_mount_t *mount = ntrip_caster_mount_new(name);
+    if (mount == NULL)
+    {
+        return ESP_FAIL;
+    }
+
+    ERROR_IF(!rtcm3_filter_parse(&mount->filter, filter),
+             return ESP_FAIL,
+             "Invalid filter %s of mount %s", filter, name);
+
+    mount->fanout = fanout_create(MOUNT_FANOUT_LEN);
+    ERROR_IF(mount->fanout == NULL,
+             return ESP_ERR_NO_MEM,
+             "Cannot create mount %s", name);
+
+    mount->parent = source;
+    mount->parent_pos = fanout_head(source->fanout);
+    mount->head = mount->scan_pos = mount->release = fanout_head(mount->fanout);
+
+    mount_count++;
+    ntrip_caster_mount_describe(mount);
+    ESP_LOGI(TAG, "mount %s = %s/%s", name, parent, filter);
+    return ESP_OK;
+}
+
+// extra mounts are set as "NAME=SOURCE/filter NAME=SOURCE/filter ...",
+// a mount whose source is not added yet, e.g. the relay, is added with its source
+static void ntrip_caster_mounts_load()
+{
+    char mounts_config[CONFIG_LEN_MAX];
+    char *saveptr;
+    bool added = true;
+
+    // a pass may add the source of an item before it
+    while (added)
+    {
+        added = false;
+        strcpy(mounts_config, config_get(CONFIG_CASTER_MOUNTS));
+        for (char *item = strtok_r(mounts_config, " ", &saveptr); item; item = strtok_r(NULL, " ", &saveptr))
+        {
+            char *parent = strchr(item, '=');
+            ERROR_IF(parent == NULL,
+                     continue,
+                     "Invalid mount %s", item);
+            *parent++ = '\0';
+
+            char *filter = strchr(parent, '/');
+            if (filter)
+            {
+                *filter++ = '\0';
+            }
+
+            if (ntrip_caster_mount_find(item, strlen(item)) != NULL ||
+                ntrip_caster_mount_find(parent, strlen(parent)) == NULL)
+            {
+                continue;
+            }
+
+            added |= ntrip_caster_mount_add_filtered(item, parent, filter ? filter : "") == ESP_OK;
+        }
+    }
+}
+
+// serve a stream of whole RTCM3 frames, e.g. the local receiver output,
+// must be called after ntrip_caster_init
+esp_err_t ntrip_caster_mount_add(const char *name, fanout_t *fanout)
+{
+    ERROR_IF(wake_fd < 0,
+             return ESP_ERR_INVALID_STATE,
+             "Caster is not started");
+
+    ntrip_caster_mount_t *mount = ntrip_caster_mount_new(name);
+    if (mount == NULL)
+    {
+        return ESP_FAIL;
+    }
+
+    mount->fanout = fanout;
+    mount->head = mount->scan_pos = mount->release = fanout_head(fanout);
+    ERROR_IF(!fanout_subscribe(fanout, ntrip_caster_notify, mount),
+             return ESP_FAIL,
+             "Cannot subscribe to mount %s", name);
+
+    mount_count++;
+    ntrip_caster_mount_describe(mount);
+    ESP_LOGI(TAG, "mount %s", name);
+
+    // the filtered views of this mount
+    ntrip_caster_mounts_load();
+    return ESP_OK;
+}
+
+// copy the frames which pass the filter from the parent fanout
+static void ntrip_caster_mount_pump(ntrip_caster_mount_t *mount, uint8_t *frame)
+{
+    fanout_t *source = mount->parent->fanout;
+    uint32_t head = fanout_head(source);
+
+    while (mount->parent_pos != head)
+    {
+        size_t len = RTCM3_HEADER_LEN;
+        if (fanout_copy(source, mount->parent_pos, frame, len) == len)
+        {
+            len = rtcm3_frame_len(frame);
+        }
+
+        if (fanout_copy(source, mount->parent_pos, frame, len) != len ||
+            fanout_overrun(source, mount->parent_pos))
+        {
+            ESP_LOGW(TAG, "mount %s overrun", mount->name);
+            mount->parent_pos = fanout_head(source);
+            return;
+        }
+
+        if (rtcm3_filter_pass(&mount->filter, rtcm3_msg_type(frame)))
+        {
+            fanout_write(mount->fanout, frame, len);
+            mount->publish_us = mount->parent->publish_us;
+        }
+        mount->parent_pos += len;
+    }
+}
+
+// the base position: the fixed one, or the current one in other modes, rounded to about 1 km
+static void ntrip_caster_position(char *buffer, size_t len)
+{
+    double lat = atof(config_get(CONFIG_BASE_LAT));
+    double lon = atof(config_get(CONFIG_BASE_LON));
+
+    if (strcmp(status_get(STATUS_GNSS_MODE), "Base-Fixed") != 0)
+    {
+        ubx_nav_pvt_t pvt;
+        uart_get_nav_pvt(&pvt);
+        if (pvt.fixType >= 2)
+        {
+            lat = pvt.lat * 1e-7;
+            lon = pvt.lon * 1e-7;
+        }
+    }
+
+    snprintf(buffer, len, "%.2f;%.2f", lat, lon);
+}
+
+static size_t ntrip_caster_table_build(char *buffer, size_t len, const char *position)
+{
+    char details[MOUNT_DETAILS_LEN];
+    char systems[MOUNT_SYSTEMS_LEN];
+    const char *country = config_get(CONFIG_CASTER_COUNTRY);
+    uint32_t bitrate;
+    size_t n = 0;
+
+    for (size_t i = 0; i < mount_count; i++)
+    {
+        portENTER_CRITICAL(&table_lock);
+        memcpy(details, mounts[i].details, sizeof(details));
+        memcpy(systems, mounts[i].systems, sizeof(systems));
+        bitrate = mounts[i].bitrate;
+        portEXIT_CRITICAL(&table_lock);
+
+        n += snprintf(buffer + n, len - n, TABLE_STREAM, mounts[i].name, mounts[i].name, details,
+                      systems[0] ? systems : "GPS+GLO+GAL+BDS+QZSS", country, position, mounts[i].auth ? 'B' : 'N', bitrate);
+        if (n >= len)
+        {
+            return len;
+        }
+    }
+    n += snprintf(buffer + n, len - n, TABLE_END);
+    return MIN(n, len);
+}
+
+// header and body in one buffer, built again if the position or any mount changed
+static void ntrip_caster_table_update()
+{
+    char position[POSITION_LEN];
+    ntrip_caster_position(position, sizeof(position));
+
+    portENTER_CRITICAL(&table_lock);
+    uint32_t version = table_version;
+    portEXIT_CRITICAL(&table_lock);
+
+    if (table_cache && version == table_cache_version && strcmp(position, table_cache_position) == 0)
+    {
+        return;
+    }
+
+    // on failure the old table is kept, it is built again at the next request
+    char *body = calloc(TABLE_LEN_MAX, sizeof(char));
+    ERROR_IF(body == NULL,
+             return,
+             "Cannot allocate sourcetable");
+
+    size_t len = ntrip_caster_table_build(body, TABLE_LEN_MAX, position);
+    size_t size = sizeof(TABLE_HEADER) + 8 + len;
+    char *cache = calloc(size, sizeof(char));
+    ERROR_IF(cache == NULL,
+             free(body);
+             return,
+             "Cannot allocate sourcetable");
+
+    size_t n = snprintf(cache, size, TABLE_HEADER, (unsigned int)len);
+    memcpy(cache + n, body, len);
+    free(body);
+
+    free(table_cache);
+    table_cache = cache;
+    table_cache_len = n + len;
+
+    strcpy(table_cache_position, position);
+    table_cache_version = version;
+}
+
+static esp_err_t mount_table_handler(httpd_req_t *req)
+{
+    httpd_handle_t hd = req->handle;
+    int sockfd = httpd_req_to_sockfd(req);
+
+    ntrip_caster_table_update();
+    ERROR_IF(table_cache == NULL,
+             return ESP_FAIL,
+             "No sourcetable to send");
+    httpd_socket_send(hd, sockfd, table_cache, table_cache_len, MSG_MORE);
+
+    return ESP_OK;
+}
+
+static void destroy_socket(int socket)
+{
+    if (socket < 0)
+        return;
+    shutdown(socket, SHUT_RDWR);
+    close(socket);
+}
+
+static bool ntrip_caster_client_active(ntrip_caster_client_t *client)
+{
+    return atomic_load_explicit(&client->state, memory_order_acquire) == CLIENT_ACTIVE;
+}
+
+// take a free slot, the caller owns it until it is made ACTIVE or FREE
+static ntrip_caster_client_t *ntrip_caster_client_claim()
+{
+    for (ntrip_caster_client_t *client = clients; client < clients + CLIENT_MAX; client++)
+    {
+        uint8_t expected = CLIENT_FREE;
+        if (atomic_compare_exchange_strong(&client->state, &expected, CLIENT_CLAIMED))
+        {
+            memset(&client->mount, 0, sizeof(ntrip_caster_client_t) - offsetof(ntrip_caster_client_t, mount));
+            return client;
+        }
+    }
+    return NULL;
+}
+
+// a claimed or active slot which holds the socket
+static ntrip_caster_client_t *ntrip_caster_client_find(int sockfd)
+{
+    for (ntrip_caster_client_t *client = clients; client < clients + CLIENT_MAX; client++)
+    {
+        if (atomic_load_explicit(&client->state, memory_order_acquire) != CLIENT_FREE && client->socket == sockfd)
+        {
+            return client;
+        }
+    }
+    return NULL;
+}
+
+// only called by the caster task, the slot is released before the socket
+// is closed, so a new connection cannot see its number in a stale slot
+static void ntrip_caster_client_remove(ntrip_caster_client_t *client)
+{
+    int socket = client->socket;
+    ntrip_auth_release(client->user);
+    atomic_store_explicit(&client->state, CLIENT_FREE, memory_order_release);
+    destroy_socket(socket);
+    sprintf(status_get(STATUS_NTRIP_CAS_STATUS), "%d", --client_count);
+}
+
+static uint32_t ntrip_caster_frame_end(fanout_t *fanout, uint32_t pos)
+{
+    uint8_t header[RTCM3_HEADER_LEN];
+    fanout_copy(fanout, pos, header, RTCM3_HEADER_LEN);
+    return pos + rtcm3_frame_len(header);
+}
+
+static size_t ntrip_caster_client_queued(ntrip_caster_client_t *client, uint32_t head)
+{
+    return client->framing_len + (client->frame_end - client->pos) + (head - client->skip_to);
+}
+
+// drop the oldest whole frames after the one being sent
+static void ntrip_caster_client_drop(fanout_t *fanout, ntrip_caster_client_t *client, uint32_t head)
+{
+    while (ntrip_caster_client_queued(client, head) > client->queue_max && client->skip_to != head)
+    {
+        uint32_t end = ntrip_caster_frame_end(fanout, client->skip_to);
+        client->dropped_frames++;
+        client->dropped_bytes += end - client->skip_to;
+        client->skip_to = end;
+    }
+}
+
+// send without blocking, return the sent bytes, 0 if the socket buffer is full, -1 on error
+static int ntrip_caster_client_write(ntrip_caster_client_t *client, const void *data, size_t len)
+{
+    int flags = client->mount->profile == MOUNT_PROFILE_THROUGHPUT ? MSG_DONTWAIT | MSG_MORE : MSG_DONTWAIT;
+    int sent = send(client->socket, data, len, flags);
+    if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+    {
+        return 0;
+    }
+    if (sent > 0)
+    {
+        client->sent_ms = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    }
+    return sent;
+}
+
+// read away what a rover sends, e.g. GGA sentences, return false if the socket is closed
+static bool ntrip_caster_client_recv(ntrip_caster_client_t *client)
+{
+    char buffer[RECV_LEN];
+    int len = recv(client->socket, buffer, sizeof(buffer), MSG_DONTWAIT);
+    return len > 0 || (len < 0 && (errno == EAGAIN || errno == EWOULDBLOCK));
+}
+
+// HTTP chunk framing: the size in hex before the data, CRLF after it
+static size_t chunk_header(char *buffer, size_t len)
+{
+    return sprintf(buffer, "%X" CARRET NEWLINE, (unsigned int)len);
+}
+
+static size_t chunk_trailer(char *buffer)
+{
+    return sprintf(buffer, CARRET NEWLINE);
+}
+
+// chunked mode, at a frame boundary: terminate the chunk of the frame just sent,
+// and open a chunk for the next frame, return true if framing bytes are queued
+static bool ntrip_caster_client_chunk(fanout_t *fanout, ntrip_caster_client_t *client, uint32_t head)
+{
+    if (client->chunk_open)
+    {
+        client->framing_len += chunk_trailer(client->framing + client->framing_len);
+        client->chunk_open = false;
+    }
+
+    if (client->pos != head)
+    {
+        uint32_t end = ntrip_caster_frame_end(fanout, client->pos);
+        client->framing_len += chunk_header(client->framing + client->framing_len, end - client->pos);
+        client->frame_end = client->skip_to = end;
+        client->chunk_open = true;
+    }
+
+    return client->framing_len > 0;
+}
+
+// at a frame boundary: skip the frames which the client filter drops
+static void ntrip_caster_client_filter(fanout_t *fanout, ntrip_caster_client_t *client, uint32_t head)
+{
+    uint8_t header[RTCM3_HEADER_LEN + 2];
+
+    while (client->pos != head)
+    {
+        if ((int32_t)(client->filter_pos - client->pos) > 0)
+        {
+            return;
+        }
+
+        fanout_copy(fanout, client->pos, header, sizeof(header));
+        uint32_t end = client->pos + rtcm3_frame_len(header);
+        client->filter_pos = end;
+        if (rtcm3_filter_pass(&client->filter, rtcm3_msg_type(header)))
+        {
+            // a chunked client opens the frame in its chunk framing
+            if (!client->chunked)
+            {
+                client->frame_end = client->skip_to = end;
+            }
+            return;
+        }
+        client->pos = client->frame_end = client->skip_to = end;
+    }
+}
+
+// append to the write buffer, as a socket would take it, return the staged bytes, 0 if the budget is used up
+static int ntrip_caster_client_stage(const void *data, size_t len)
+{
+    len = MIN(len, write_budget - write_len);
+    memcpy(write_buffer + write_len, data, len);
+    write_len += len;
+    return len;
+}
+
+// stage the released data of the client, frame by frame, as far as the budget goes,
+// return false if the client has to be removed
+static bool ntrip_caster_client_gather(fanout_t *fanout, ntrip_caster_client_t *client)
+{
+    uint32_t head = client->mount->release;
+    const uint8_t *data;
+    size_t len;
+    int sent;
+
+    ERROR_IF(fanout_overrun(fanout, client->pos),
+             return false,
+             "socket %d overrun", client->socket);
+
+    if (ntrip_caster_client_queued(client, head) > client->queue_max)
+    {
+        ERROR_IF(client->policy == CLIENT_POLICY_DISCONNECT,
+                 return false,
+                 "socket %d is too slow", client->socket);
+        ntrip_caster_client_drop(fanout, client, head);
+    }
+
+    while (true)
+    {
+        // chunk framing goes out before any frame data
+        if (client->framing_len > 0)
+        {
+            sent = ntrip_caster_client_stage(client->framing, client->framing_len);
+            if (sent == 0)
+            {
+                return true;
+            }
+
+            client->framing_len -= sent;
+            memmove(client->framing, client->framing + sent, client->framing_len);
+            if (client->framing_len > 0)
+            {
+                return true;
+            }
+        }
+
+        // jump over dropped frames
+        if (client->pos == client->frame_end && client->skip_to != client->frame_end)
+        {
+            client->pos = client->frame_end = client->skip_to;
+        }
+
+        if (client->filter.count && client->pos == client->frame_end)
+        {
+            ntrip_caster_client_filter(fanout, client, head);
+        }
+
+        if (client->chunked && client->pos == client->frame_end && ntrip_caster_client_chunk(fanout, client, head))
+        {
+            continue;
+        }
+
+        // a chunked or filtered client stops at the end of each frame
+        bool framed = client->chunked || client->filter.count || client->skip_to != client->frame_end;
+        uint32_t limit = framed ? client->frame_end : head;
+        if (client->pos == limit)
+        {
+            return true;
+        }
+
+        len = MIN(fanout_peek(fanout, client->pos, &data), limit - client->pos);
+        sent = ntrip_caster_client_stage(data, len);
+        if (sent == 0)
+        {
+            return true; // write buffer is full, send it first
+        }
+
+        // the producer may have wrapped the ring while the data was copied
+        ERROR_IF(fanout_overrun(fanout, client->pos),
+                 write_len = 0;
+                 return false,
+                 "socket %d overrun", client->socket);
+
+        client->pos += sent;
+
+        // follow frame boundaries
+        while ((int32_t)(client->pos - client->frame_end) > 0)
+        {
+            client->frame_end = ntrip_caster_frame_end(fanout, client->frame_end);
+            client->skip_to = client->frame_end;
+        }
+
+        if (sent < len)
+        {
+            return true;
+        }
+    }
+}
+
+/*
+ * token bucket of a paced client: when an epoch is released, the rate is set to
+ * spread the queue over the pacing window, return the bytes to send now,
+ * 0 until a whole TCP segment, or the rest of the queue, can be sent
+ */
+static size_t ntrip_caster_client_pace(ntrip_caster_client_t *client)
 {
-    httpd_handle_t hd;
-    int socket;
-    SLIST_ENTRY(ntrip_caster_client_t)
-    next;
-} ntrip_caster_client_t;
+    if (pacing_window_ms == 0)
+    {
+        return CLIENT_WRITE_LEN;
+    }
 
-static SLIST_HEAD(caster_clients_list_t, ntrip_caster_client_t) caster_clients_list;
+    uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    size_t queued = ntrip_caster_client_queued(client, client->mount->release);
 
-static char TABLE_RESPONSE[] =
-    "SOURCETABLE 200 OK" CARRET NEWLINE
-    "Content-Type: text/plain" CARRET NEWLINE
-    "Content-Length: 115" CARRET NEWLINE
-        CARRET NEWLINE
-    "STR;BASE;BASE;RTCM 3;;2;GPS+GLO+GAL+BDS+QZSS;GNSS;VN;21.028511;105.804817;0;0;GNSS;none;N;N;9600;" CARRET NEWLINE
-    "ENDSOURCETABLE" CARRET NEWLINE
-        CARRET NEWLINE;
+    // an idle client starts each epoch with a full bucket
+    int64_t tokens = client->pace_tokens + (int64_t)client->pace_rate * (now - client->pace_ms) / 1000;
+    client->pace_tokens = client->pace_queued == 0 ? PACING_BURST : MIN(tokens, PACING_BURST);
+    client->pace_ms = now;
 
-static char STREAM_RESPONSE[] =
-    "ICY 200 OK" CARRET NEWLINE;
+    // a new epoch is spread over the window and the rest of the previous one goes out at once,
+    // other frames only raise the rate to send the queue within the window
+    int32_t extra = 0;
+    if (queued > client->pace_queued)
+    {
+        if (client->pace_epoch != client->mount->epoch_start)
+        {
+            client->pace_epoch = client->mount->epoch_start;
+            client->pace_rate = (queued - client->pace_queued) * 1000 / pacing_window_ms;
+            extra = client->pace_queued;
+        }
+        else
+        {
+            client->pace_rate = MAX(client->pace_rate, queued * 1000 / pacing_window_ms);
+        }
+        client->pace_rate = MAX(client->pace_rate, PACING_RATE_MIN);
+        client->pace_queued = queued;
+    }
 
-static char client_count = 0;
+    if (client->pace_tokens + extra < (int32_t)MIN(queued, PACING_BURST))
+    {
+        return 0;
+    }
+    return MIN(client->pace_tokens + extra, CLIENT_WRITE_LEN);
+}
 
-static esp_err_t mount_table_handler(httpd_req_t *req)
+// send the released data in one write, without blocking,
+// return false if the client has to be removed
+static bool ntrip_caster_client_send(fanout_t *fanout, ntrip_caster_client_t *client)
 {
-    httpd_handle_t hd = req->handle;
-    int sockfd = httpd_req_to_sockfd(req);
+    // the send state from pos on, to replay a partial write
+    uint8_t state[sizeof(ntrip_caster_client_t) - offsetof(ntrip_caster_client_t, pos)];
+    memcpy(state, &client->pos, sizeof(state));
 
-    httpd_socket_send(hd, sockfd, TABLE_RESPONSE, strlen(TABLE_RESPONSE), MSG_MORE);
+    write_len = 0;
+    write_budget = ntrip_caster_client_pace(client);
+    if (!ntrip_caster_client_gather(fanout, client))
+    {
+        return false;
+    }
+    if (write_len == 0)
+    {
+        return true;
+    }
 
-    return ESP_OK;
+    int sent = ntrip_caster_client_write(client, write_buffer, write_len);
+    if (sent < 0)
+    {
+        return false;
+    }
+    client->mount->bytes_out += sent;
+    client->mount->rate_slot_bytes += sent;
+
+    // the socket took less, gather again only what was sent
+    if (sent < write_len)
+    {
+        memcpy(&client->pos, state, sizeof(state));
+        write_len = 0;
+        write_budget = sent;
+        ntrip_caster_client_gather(fanout, client);
+    }
+
+    client->pace_tokens = MAX(client->pace_tokens - sent, 0);
+    client->pace_queued = ntrip_caster_client_queued(client, client->mount->release);
+    return true;
 }
 
-static void destroy_socket(int socket)
+static bool ntrip_caster_mounts_changed()
 {
-    if (socket < 0)
+    for (size_t i = 0; i < mount_count; i++)
+    {
+        if (mounts[i].parent == NULL && fanout_head(mounts[i].fanout) != mounts[i].head)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// frames are held until their epoch is complete
+static bool ntrip_caster_mounts_holding()
+{
+    for (size_t i = 0; i < mount_count; i++)
+    {
+        if (mounts[i].release != mounts[i].scan_pos)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+#ifdef NTRIP_CASTER_MEASURE_ACK
+// TCP sequence numbers of a client socket, read in the tcpip thread
+typedef struct ntrip_caster_tcp_seq_t
+{
+    struct tcpip_api_call_data call;
+    int socket;
+    uint32_t lastack; // next byte the rover has to acknowledge
+    uint32_t snd_lbb; // next byte to be written
+} ntrip_caster_tcp_seq_t;
+
+// called by tcpip_api_call(), so the pcb cannot be freed while it is read
+static err_t ntrip_caster_tcp_seq_read(struct tcpip_api_call_data *call)
+{
+    ntrip_caster_tcp_seq_t *seq = (ntrip_caster_tcp_seq_t *)call;
+    struct lwip_sock *sock = lwip_socket_dbg_get_socket(seq->socket);
+    if (sock == NULL || sock->conn == NULL || sock->conn->pcb.tcp == NULL)
+    {
+        return ERR_CONN;
+    }
+
+    seq->lastack = sock->conn->pcb.tcp->lastack;
+    seq->snd_lbb = sock->conn->pcb.tcp->snd_lbb;
+    return ERR_OK;
+}
+#endif
+
+/*
+ * latency samples: source to socket when the queue of a client empties after a release,
+ * then socket to ACK when the rover has acknowledged that data, polled every POLL_MS,
+ * only with NTRIP_CASTER_MEASURE_ACK
+ */
+static void ntrip_caster_client_measure(ntrip_caster_client_t *client)
+{
+    ntrip_caster_mount_t *mount = client->mount;
+    uint32_t now = esp_timer_get_time();
+
+    bool sample = client->measure_release != mount->release && ntrip_caster_client_queued(client, mount->release) == 0;
+    if (!sample && !client->ack_wait)
+    {
         return;
-    shutdown(socket, SHUT_RDWR);
-    close(socket);
+    }
+
+#ifdef NTRIP_CASTER_MEASURE_ACK
+    ntrip_caster_tcp_seq_t seq = {.socket = client->socket};
+    if (tcpip_api_call(ntrip_caster_tcp_seq_read, &seq.call) != ERR_OK)
+    {
+        return;
+    }
+
+    if (client->ack_wait && (int32_t)(seq.lastack - client->ack_seq) >= 0)
+    {
+        uint32_t us = now - client->ack_us;
+        mount->ack_samples++;
+        mount->ack_sum_us += us;
+        mount->ack_max_us = MAX(mount->ack_max_us, us);
+        client->ack_wait = false;
+    }
+#endif
+
+    if (!sample)
+    {
+        return;
+    }
+
+    uint32_t us = now - mount->release_us;
+    mount->latency_samples++;
+    mount->latency_sum_us += us;
+    mount->latency_max_us = MAX(mount->latency_max_us, us);
+    client->measure_release = mount->release;
+
+#ifdef NTRIP_CASTER_MEASURE_ACK
+    if (!client->ack_wait)
+    {
+        client->ack_wait = true;
+        client->ack_seq = seq.snd_lbb;
+        client->ack_us = now;
+    }
+#endif
 }
 
-static void ntrip_caster_client_remove(ntrip_caster_client_t *caster_client)
+// watch all clients for reading, and the clients with queued data for writing,
+// paced clients and clients waiting for an ACK are polled on a timer instead
+static int ntrip_caster_fds(fd_set *read_fds, fd_set *write_fds, bool *polled)
 {
-    destroy_socket(caster_client->socket);
-    SLIST_REMOVE(&caster_clients_list, caster_client, ntrip_caster_client_t, next);
-    free(caster_client);
-    client_count--;
-    sprintf(status_get(STATUS_NTRIP_CAS_STATUS), "%d", client_count);
+    int max_fd = wake_fd;
+
+    FD_ZERO(read_fds);
+    FD_ZERO(write_fds);
+    FD_SET(wake_fd, read_fds);
+    for (ntrip_caster_client_t *client = clients; client < clients + CLIENT_MAX; client++)
+    {
+        if (!ntrip_caster_client_active(client))
+        {
+            continue;
+        }
+
+        FD_SET(client->socket, read_fds);
+        if (ntrip_caster_client_queued(client, client->mount->release) > 0)
+        {
+            if (pacing_window_ms)
+            {
+                *polled = true;
+            }
+            else
+            {
+                FD_SET(client->socket, write_fds);
+            }
+        }
+        *polled |= client->ack_wait;
+        max_fd = MAX(max_fd, client->socket);
+    }
+
+    return max_fd;
 }
 
-static void uart_rtcm3_read_event_handler(void *event_handler_arg, esp_event_base_t event_base, int32_t event_id, void *event_data)
+// keep a socket alive if nothing was sent to it for KEEP_ALIVE_MS,
+// whatever the other mounts are doing
+static void ntrip_caster_keep_alive(ntrip_caster_client_t *client)
 {
-    // ESP_LOGW(TAG, "Got RTCM3: %s", (char *)event_data);
-    // ESP_LOGW(TAG, "x");
-    ntrip_caster_client_t *client, *client_tmp;
-    SLIST_FOREACH_SAFE(client, &caster_clients_list, next, client_tmp)
+    ntrip_caster_mount_t *mount = client->mount;
+    uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+
+    if (now - client->sent_ms < KEEP_ALIVE_MS || ntrip_caster_client_queued(client, mount->release) > 0)
+    {
+        return;
+    }
+
+    if (client->chunked)
     {
-        // ESP_LOGW(TAG, "found socket: %d", client->socket);
-        int len = httpd_socket_send(client->hd, client->socket, event_data, event_id, MSG_MORE);
-        ERROR_IF(len < 0,
+        // as a whole chunk, sent with the framing bytes
+        memcpy(client->framing, KEEP_ALIVE_CHUNK, strlen(KEEP_ALIVE_CHUNK));
+        client->framing_len = strlen(KEEP_ALIVE_CHUNK);
+        ERROR_IF(!ntrip_caster_client_send(mount->fanout, client),
                  ntrip_caster_client_remove(client),
                  "delete socket %d", client->socket);
+        return;
     }
+
+    int sent = ntrip_caster_client_write(client, "GNSS", 4);
+    ERROR_IF(sent < 0,
+             ntrip_caster_client_remove(client),
+             "delete socket %d", client->socket);
 }
 
-static void custom_httpd_close_func(httpd_handle_t hd, int sockfd)
+static void ntrip_caster_keep_alives()
+{
+    for (ntrip_caster_client_t *client = clients; client < clients + CLIENT_MAX; client++)
+    {
+        if (ntrip_caster_client_active(client))
+        {
+            ntrip_caster_keep_alive(client);
+        }
+    }
+}
+
+/*
+ * one task serves all clients: it sleeps in select() until new data is
+ * published, a client with queued data can take more, or a client closes
+ */
+static void ntrip_caster_task(void *ctx)
+{
+    uint8_t *frame = calloc(RTCM3_FRAME_LEN_MAX, sizeof(uint8_t));
+    write_buffer = calloc(CLIENT_WRITE_LEN, sizeof(uint8_t));
+    ntrip_caster_mount_t *mount;
+    ntrip_caster_client_t *client;
+    fd_set read_fds, write_fds;
+    struct timeval timeout;
+
+    ESP_LOGI(TAG, "Start ntrip_caster_task");
+    while (true)
+    {
+        // wake up in time to release held frames, and to poll clients
+        bool polled = false;
+        int max_fd = ntrip_caster_fds(&read_fds, &write_fds, &polled);
+        bool holding = ntrip_caster_mounts_holding();
+        timeout.tv_sec = 0;
+        timeout.tv_usec = (polled ? POLL_MS : holding ? COALESCE_GAP_MS : KEEP_ALIVE_MS) * 1000;
+        int ready = select(max_fd + 1, &read_fds, &write_fds, NULL, &timeout);
+        ERROR_IF(ready < 0,
+                 vTaskDelay(pdMS_TO_TICKS(RETRY_MS));
+                 continue,
+                 "select failed: %d", errno);
+
+        if (FD_ISSET(wake_fd, &read_fds))
+        {
+            uint64_t count;
+            read(wake_fd, &count, sizeof(count));
+        }
+
+        // a slot which became active after select() is not in the fd sets
+        for (client = clients; client < clients + CLIENT_MAX; client++)
+        {
+            if (ntrip_caster_client_active(client) &&
+                FD_ISSET(client->socket, &read_fds) && !ntrip_caster_client_recv(client))
+            {
+                ESP_LOGI(TAG, "socket %d closed", client->socket);
+                ntrip_caster_client_remove(client);
+            }
+        }
+
+        if (ready == 0 && !holding && !polled && !ntrip_caster_mounts_changed())
+        {
+            for (mount = mounts; mount < mounts + mount_count; mount++)
+            {
+                ntrip_caster_mount_scan(mount);
+                ntrip_caster_mount_rate(mount);
+            }
+            ntrip_caster_keep_alives();
+            continue;
+        }
+
+        // a parent mount is always added before its filtered mounts
+        for (mount = mounts; mount < mounts + mount_count; mount++)
+        {
+            if (mount->parent)
+            {
+                ntrip_caster_mount_pump(mount, frame);
+            }
+            uint32_t release = mount->release;
+            ntrip_caster_mount_scan(mount);
+            ntrip_caster_mount_release(mount);
+            ntrip_caster_mount_rate(mount);
+            if (mount->release != release)
+            {
+                mount->release_us = mount->publish_us;
+            }
+
+            uint32_t head = fanout_head(mount->fanout);
+            mount->bytes_in += head - mount->head;
+            mount->head = head;
+        }
+
+        for (client = clients; client < clients + CLIENT_MAX; client++)
+        {
+            if (!ntrip_caster_client_active(client))
+            {
+                continue;
+            }
+
+            if (!ntrip_caster_client_send(client->mount->fanout, client))
+            {
+                ESP_LOGW(TAG, "delete socket %d", client->socket);
+                ntrip_caster_client_remove(client);
+            }
+            else if (measure)
+            {
+                ntrip_caster_client_measure(client);
+            }
+        }
+
+        ntrip_caster_keep_alives();
+    }
+}
+
+// one line per client: mount, socket, queued bytes, dropped frames, dropped bytes
+size_t ntrip_caster_clients_info(char *buffer, size_t len)
+{
+    size_t n = 0;
+    ntrip_caster_client_t *client;
+
+    buffer[0] = '\0';
+    for (size_t i = 0; i < mount_count; i++)
+    {
+        uint32_t head = fanout_head(mounts[i].fanout);
+        for (client = clients; client < clients + CLIENT_MAX; client++)
+        {
+            if (!ntrip_caster_client_active(client) || client->mount != &mounts[i])
+            {
+                continue;
+            }
+
+            int l = snprintf(buffer + n, len - n, "%s %d %u %" PRIu32 " %" PRIu32 NEWLINE,
+                             mounts[i].name,
+                             client->socket,
+                             (unsigned)ntrip_caster_client_queued(client, head),
+                             client->dropped_frames,
+                             client->dropped_bytes);
+            if (l < 0 || l >= len - n)
+            {
+                return n;
+            }
+            n += l;
+        }
+    }
+
+    return n;
+}
+
+/*
+ * one line per mount: mount, clients, bytes in, bytes out, upstream bytes saved,
+ * peak and average bytes sent per 100 ms slot over the last 10 s,
+ * the saved bytes are what clients would have read on their own connections
+ */
+size_t ntrip_caster_mounts_info(char *buffer, size_t len)
+{
+    size_t n = 0;
+    ntrip_caster_client_t *client;
+
+    buffer[0] = '\0';
+    for (size_t i = 0; i < mount_count; i++)
+    {
+        ntrip_caster_mount_t *mount = &mounts[i];
+        unsigned count = 0;
+        for (client = clients; client < clients + CLIENT_MAX; client++)
+        {
+            if (ntrip_caster_client_active(client) && client->mount == mount)
+            {
+                count++;
+            }
+        }
+
+        uint64_t saved = mount->bytes_out > mount->bytes_in ? mount->bytes_out - mount->bytes_in : 0;
+        int l = snprintf(buffer + n, len - n, "%s %u %" PRIu64 " %" PRIu64 " %" PRIu64 " %" PRIu32 " %" PRIu32 NEWLINE,
+                         mount->name, count, mount->bytes_in, mount->bytes_out, saved, mount->rate_peak, mount->rate_avg);
+        if (l < 0 || l >= len - n)
+        {
+            break;
+        }
+        n += l;
+    }
+
+    return n;
+}
+
+/*
+ * one line per mount: mount, profile, source to socket samples, average and max microseconds,
+ * then the same for socket to ACK, all 0 unless cas_measure is set
+ */
+size_t ntrip_caster_latency_info(char *buffer, size_t len)
 {
-    // if socket is in the streaming list
-    bool found = false;
-    ntrip_caster_client_t *client, *client_tmp;
-    SLIST_FOREACH_SAFE(client, &caster_clients_list, next, client_tmp)
+    size_t n = 0;
+
+    buffer[0] = '\0';
+    for (size_t i = 0; i < mount_count; i++)
     {
-        if (client->socket == sockfd)
+        ntrip_caster_mount_t *mount = &mounts[i];
+        uint32_t samples = mount->latency_samples;
+        uint32_t acks = mount->ack_samples;
+        int l = snprintf(buffer + n, len - n, "%s %s %" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32 NEWLINE,
+                         mount->name,
+                         MOUNT_PROFILE_NAMES[mount->profile],
+                         samples,
+                         samples ? (uint32_t)(mount->latency_sum_us / samples) : 0,
+                         mount->latency_max_us,
+                         acks,
+                         acks ? (uint32_t)(mount->ack_sum_us / acks) : 0,
+                         mount->ack_max_us);
+        if (l < 0 || l >= len - n)
         {
-            found = true;
+            break;
         }
+        n += l;
     }
 
-    // if not, then close it
-    if (!found)
+    return n;
+}
+
+static void custom_httpd_close_func(httpd_handle_t hd, int sockfd)
+{
+    // if socket is not a streaming client, then close it
+    ntrip_caster_client_t *client = ntrip_caster_client_find(sockfd);
+    if (client == NULL)
     {
         destroy_socket(sockfd);
+        return;
+    }
+
+    // httpd has released a handed over socket, the caster task serves it from now on
+    uint8_t expected = CLIENT_CLAIMED;
+    if (atomic_compare_exchange_strong(&client->state, &expected, CLIENT_ACTIVE))
+    {
+        ntrip_caster_notify(NULL);
+    }
+}
+
+/*
+ * send the cached station frames right after the response, then start the stream
+ * at the last complete MSM epoch, so a new rover can fix without waiting for the next cycle,
+ * the epoch is skipped if it does not fit in the client queue
+ */
+static void ntrip_caster_client_start(httpd_req_t *req, ntrip_caster_client_t *client)
+{
+    ntrip_caster_mount_t *mount = client->mount;
+    uint8_t *frames = calloc(CACHE_TYPES_COUNT, CACHE_FRAME_LEN);
+    uint8_t *data = calloc(CACHE_TYPES_COUNT, CACHE_FRAME_LEN + FRAMING_LEN);
+    uint16_t lens[CACHE_TYPES_COUNT];
+    uint32_t start = 0;
+    bool epoch_valid = false;
+
+    if (frames && data)
+    {
+        portENTER_CRITICAL(&cache_lock);
+        memcpy(lens, mount->cache_len, sizeof(lens));
+        memcpy(frames, mount->cache, CACHE_TYPES_COUNT * CACHE_FRAME_LEN);
+        start = mount->epoch_start;
+        epoch_valid = mount->epoch_valid;
+        portEXIT_CRITICAL(&cache_lock);
+
+        size_t len = 0;
+        for (size_t i = 0; i < CACHE_TYPES_COUNT; i++)
+        {
+            if (lens[i] == 0 || !rtcm3_filter_pass(&client->filter, CACHE_TYPES[i]))
+            {
+                continue;
+            }
+            if (client->chunked)
+            {
+                len += chunk_header((char *)data + len, lens[i]);
+            }
+            memcpy(data + len, frames + i * CACHE_FRAME_LEN, lens[i]);
+            len += lens[i];
+            if (client->chunked)
+            {
+                len += chunk_trailer((char *)data + len);
+            }
+        }
+        if (len > 0)
+        {
+            httpd_socket_send(req->handle, client->socket, (char *)data, len, MSG_MORE);
+        }
+    }
+    free(frames);
+    free(data);
+
+    uint32_t release = mount->release;
+    if (!epoch_valid || release - start > client->queue_max || fanout_overrun(mount->fanout, start))
+    {
+        start = release;
     }
+    client->pos = client->frame_end = client->skip_to = client->filter_pos = start;
+    client->measure_release = release;
+    client->sent_ms = xTaskGetTickCount() * portTICK_PERIOD_MS;
 }
 
 static esp_err_t base_stream_handler(httpd_req_t *req)
 {
-    ntrip_caster_client_t *client = malloc(sizeof(ntrip_caster_client_t));
-    client->hd = req->handle;
+    // mount name is the path up to the query string, others get the sourcetable
+    const char *name = req->uri + 1;
+    ntrip_caster_mount_t *mount = ntrip_caster_mount_find(name, strcspn(name, "?"));
+    if (mount == NULL)
+    {
+        return mount_table_handler(req);
+    }
+
+    // e.g. /BASE?types=1005:10,1074 keeps one 1005 in 10 and all 1074
+    rtcm3_filter_t filter = {0};
+    char query[QUERY_LEN] = "";
+    char types[QUERY_LEN] = "";
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        httpd_query_key_value(query, "types", types, sizeof(types)) == ESP_OK &&
+        !rtcm3_filter_parse(&filter, types))
+    {
+        int sockfd = httpd_req_to_sockfd(req);
+        ESP_LOGW(TAG, "socket %d invalid types %s", sockfd, types);
+        httpd_socket_send(req->handle, sockfd, BAD_REQUEST_RESPONSE, strlen(BAD_REQUEST_RESPONSE), 0);
+        httpd_sess_trigger_close(req->handle, sockfd);
+        return ESP_OK;
+    }
+
+    // users are checked on their base64 credential as sent
+    ntrip_auth_user_t *user = NULL;
+    if (mount->auth)
+    {
+        char authorization[AUTHORIZATION_LEN] = "";
+        httpd_req_get_hdr_value_str(req, "Authorization", authorization, sizeof(authorization));
+
+        esp_err_t err = ntrip_auth_acquire(mount->name, authorization, &user);
+        if (err != ESP_OK)
+        {
+            const char *response = err == ESP_ERR_INVALID_STATE ? FORBIDDEN_RESPONSE : UNAUTHORIZED_RESPONSE;
+            int sockfd = httpd_req_to_sockfd(req);
+            ESP_LOGW(TAG, "socket %d denied on %s", sockfd, mount->name);
+            httpd_socket_send(req->handle, sockfd, response, strlen(response), 0);
+            httpd_sess_trigger_close(req->handle, sockfd);
+            return ESP_OK;
+        }
+    }
+
+    ntrip_caster_client_t *client = ntrip_caster_client_claim();
+    if (client == NULL)
+    {
+        int sockfd = httpd_req_to_sockfd(req);
+        ESP_LOGW(TAG, "socket %d rejected, no free slot", sockfd);
+        httpd_socket_send(req->handle, sockfd, UNAVAILABLE_RESPONSE, strlen(UNAVAILABLE_RESPONSE), 0);
+        httpd_sess_trigger_close(req->handle, sockfd);
+        ntrip_auth_release(user);
+        return ESP_OK;
+    }
+
+    client->mount = mount;
+    client->user = user;
     client->socket = httpd_req_to_sockfd(req);
-    ESP_LOGI(TAG, "new socket: %d", client->socket);
-    SLIST_INSERT_HEAD(&caster_clients_list, client, next);
-    client_count++;
-    sprintf(status_get(STATUS_NTRIP_CAS_STATUS), "%d", client_count);
+    client->filter = filter;
+    ESP_LOGI(TAG, "new socket: %d on %s", client->socket, mount->name);
+
+    // a low latency mount pushes each write at once
+    if (mount->profile == MOUNT_PROFILE_LOW_LATENCY)
+    {
+        int nodelay = 1;
+        setsockopt(client->socket, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+    }
+
+    // queue limit and slow client policy
+    client->queue_max = atoi(config_get(CONFIG_CASTER_QUEUE));
+    if (client->queue_max == 0)
+    {
+        client->queue_max = CLIENT_QUEUE_DEFAULT;
+    }
+    client->queue_max = MIN(client->queue_max, CLIENT_QUEUE_MAX);
+    client->policy = strcmp(config_get(CONFIG_CASTER_POLICY), "disconnect") == 0
+                         ? CLIENT_POLICY_DISCONNECT
+                         : CLIENT_POLICY_DROP_OLDEST;
 
-    httpd_socket_send(client->hd, client->socket, STREAM_RESPONSE, strlen(STREAM_RESPONSE), MSG_MORE);
+    // NTRIP v2 clients get a chunked HTTP/1.1 stream
+    char version[16] = "";
+    httpd_req_get_hdr_value_str(req, "Ntrip-Version", version, sizeof(version));
+    client->chunked = strstr(version, "Ntrip/2.0") != NULL;
+
+    if (client->chunked)
+    {
+        httpd_socket_send(req->handle, client->socket, STREAM_RESPONSE_V2, strlen(STREAM_RESPONSE_V2), MSG_MORE);
+    }
+    else
+    {
+        httpd_socket_send(req->handle, client->socket, STREAM_RESPONSE, strlen(STREAM_RESPONSE), MSG_MORE);
+    }
+
+    ntrip_caster_client_start(req, client);
+    sprintf(status_get(STATUS_NTRIP_CAS_STATUS), "%d", ++client_count);
+
+    // hand the socket over to the caster task, httpd frees the session,
+    // then custom_httpd_close_func keeps the socket open and activates the slot
+    if (httpd_sess_trigger_close(req->handle, client->socket) != ESP_OK)
+    {
+        ntrip_auth_release(user);
+        atomic_store_explicit(&client->state, CLIENT_FREE, memory_order_release);
+        sprintf(status_get(STATUS_NTRIP_CAS_STATUS), "%d", --client_count);
+        return ESP_FAIL;
+    }
 
     return ESP_OK;
 }
 
-httpd_uri_t _mount_table_handler = {
-    .uri = "/",
-    .method = HTTP_GET,
-    .handler = mount_table_handler,
-    .user_ctx = NULL,
-};
-
 httpd_uri_t _base_stream_handler = {
-    .uri = "/BASE",
+    .uri = "/*",
     .method = HTTP_GET,
     .handler = base_stream_handler,
     .user_ctx = NULL,
@@ -150,19 +1786,8 @@ esp_err_t custom_httpd_err_func(httpd_req_t *req, httpd_err_code_t error)
 {
     int sockfd = httpd_req_to_sockfd(req);
 
-    // if socket is in the streaming list
-    bool found = false;
-    ntrip_caster_client_t *client, *client_tmp;
-    SLIST_FOREACH_SAFE(client, &caster_clients_list, next, client_tmp)
-    {
-        if (client->socket == sockfd)
-        {
-            found = true;
-        }
-    }
-
-    // if it is, keep socket open
-    if (found)
+    // if socket is a streaming client, keep it open
+    if (ntrip_caster_client_find(sockfd))
     {
         return ESP_OK;
     }
@@ -187,12 +1812,27 @@ esp_err_t ntrip_caster_init()
     config.keep_alive_count = 3;
     config.close_fn = custom_httpd_close_func;
 
+    ntrip_auth_init();
+    pacing_window_ms = atoi(config_get(CONFIG_CASTER_PACING));
+    measure = atoi(config_get(CONFIG_CASTER_MEASURE)) != 0;
+
+    esp_vfs_eventfd_config_t eventfd_config = ESP_VFS_EVENTD_CONFIG_DEFAULT();
+    esp_vfs_eventfd_register(&eventfd_config); // fails harmlessly if already registered
+    wake_fd = eventfd(0, 0);
+    ERROR_IF(wake_fd < 0,
+             return ESP_FAIL,
+             "Cannot create eventfd");
+
+    xTaskCreate(ntrip_caster_task, "ntrip_caster_task", 4096, NULL, 10, NULL);
+
+    // the local receiver and its filtered views, before any rover can ask for them
+    ntrip_caster_mount_add("BASE", uart_rtcm3_fanout());
+
     err = httpd_start(&server, &config);
     ERROR_IF(err != ESP_OK,
              return ESP_FAIL,
              "Failed to start file server!");
 
-    httpd_register_uri_handler(server, &_mount_table_handler);
     httpd_register_uri_handler(server, &_base_stream_handler);
     httpd_register_err_handler(server, HTTPD_400_BAD_REQUEST, custom_httpd_err_func);
     httpd_register_err_handler(server, HTTPD_501_METHOD_NOT_IMPLEMENTED, custom_httpd_err_func);
@@ -200,8 +1840,6 @@ esp_err_t ntrip_caster_init()
 
     ESP_LOGI(TAG, "Starting NTRIP Server on port %d", config.server_port);
 
-    uart_register_handler(UART_RTCM3_EVENT_READ, uart_rtcm3_read_event_handler);
-
-    sprintf(status_get(STATUS_NTRIP_CAS_STATUS), "%d", client_count);
+    sprintf(status_get(STATUS_NTRIP_CAS_STATUS), "%d", atomic_load(&client_count));
     return err;
 }
\ No newline at end of file
@@ -25,15 +25,23 @@
 #include "status.h"
 #include "uart.h"
 #include "ping.h"
+#include "fanout.h"
+#include "rtcm3.h"
+#include "ntrip_caster.h"
 #include "ntrip_client.h"
 
 #define BUFFER_SIZE 2048
+#define RELAY_FANOUT_LEN 16384
 
 static const char *TAG = "NTRIP_CLIENT";
 static char *source_table;
 static esp_http_client_handle_t ntrip_client = NULL;
 static bool isRequestedDisconnect = false;
 
+// corrections are also served on a local caster mount in relay mode
+static fanout_t *relay_fanout = NULL;
+static rtcm3_parser_t *relay_parser = NULL;
+
 esp_err_t ntrip_client_init()
 {
     esp_err_t err = ESP_OK;
@@ -42,6 +50,18 @@ esp_err_t ntrip_client_init()
     source_table[0] = '0';  // indicate that source table is not valid
     source_table[1] = '\r'; // indicate that source table is not valid
 
+    char *relay = config_get(CONFIG_NTRIP_RELAY);
+    if (strlen(relay) > 0)
+    {
+        relay_fanout = fanout_create(RELAY_FANOUT_LEN);
+        relay_parser = calloc(1, sizeof(rtcm3_parser_t));
+        ERROR_IF(relay_fanout == NULL || relay_parser == NULL,
+                 return ESP_ERR_NO_MEM,
+                 "Cannot create relay %s", relay);
+
+        err = ntrip_caster_mount_add(relay, relay_fanout);
+    }
+
     return err;
 }
 
@@ -152,6 +172,12 @@ static void uart_status_read_event_handler(void *event_handler_arg, esp_event_ba
     }
 }
 
+// the caster serves whole frames, each one is written once for all relay clients
+static void ntrip_client_relay_frame_handler(const uint8_t *frame, size_t len, void *ctx)
+{
+    fanout_write(relay_fanout, frame, len);
+}
+
 static void ntrip_client_stream_task(void *args)
 {
     status_set(STATUS_NTRIP_CLI_STATUS, "Connecting");
@@ -209,11 +235,20 @@ static void ntrip_client_stream_task(void *args)
 
     status_set(STATUS_NTRIP_CLI_STATUS, "Connected");
 
+    if (relay_parser)
+    {
+        rtcm3_parser_init(relay_parser);
+    }
+
     char *buffer = malloc(BUFFER_SIZE);
     int len;
     while ((len = esp_http_client_read(ntrip_client, buffer, BUFFER_SIZE)) >= 0)
     {
         ubx_write_rtcm3(buffer, len);
+        if (relay_parser)
+        {
+            rtcm3_parser_feed(relay_parser, (const uint8_t *)buffer, len, ntrip_client_relay_frame_handler, NULL);
+        }
         if (isRequestedDisconnect)
             break;
     }
@@ -0,0 +1,360 @@
+/*
+ * This file is part of the ESP32-GNSS-Base-Station firmware, published
+ * at (https://github.com/vuquangtrong/esp32-gnss-base-station).
+ * Copyright (c) 2023 Vu Quang Trong.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netdb.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <mbedtls/base64.h>
+
+#include "util.h"
+#include "config.h"
+#include "status.h"
+#include "uart.h"
+#include "fanout.h"
+#include "rtcm3.h"
+#include "ntrip_server.h"
+
+#define BACKOFF_MIN_MS 1000
+#define BACKOFF_MAX_MS 64000
+#define STABLE_MS 60000 // a connection kept this long resets the backoff
+#define EPOCH_GAP_MS 100
+#define IDLE_CHECK_MS 1000
+#define SOCKET_TIMEOUT_S 5
+#define REQUEST_LEN 512
+#define RESPONSE_LEN 256
+#define CREDENTIAL_LEN 128
+
+// one epoch is sent in one write, with room for the chunk framing of NTRIP v2
+#define EPOCH_LEN_MAX 4096
+#define CHUNK_HEADER_LEN 8 // hex length and CRLF, right aligned
+#define CHUNK_TRAILER_LEN 2
+
+static const char *TAG = "NTRIP_SERVER";
+
+static const char *SOURCE_REQUEST =
+    "SOURCE %s /%s\r\n"
+    "Source-Agent: NTRIP GNSS/1.0\r\n"
+    "\r\n";
+
+static const char *POST_REQUEST =
+    "POST /%s HTTP/1.1\r\n"
+    "Host: %s:%d\r\n"
+    "Ntrip-Version: Ntrip/2.0\r\n"
+    "User-Agent: NTRIP GNSS/1.0\r\n"
+    "Authorization: Basic %s\r\n"
+    "Transfer-Encoding: chunked\r\n"
+    "Connection: close\r\n"
+    "\r\n";
+
+static TaskHandle_t ntrip_server_task_handle = NULL;
+static bool is_v2 = true;
+
+static uint8_t *epoch;
+static size_t epoch_len = 0;
+
+static void ntrip_server_notify(void *arg)
+{
+    xTaskNotifyGive(ntrip_server_task_handle);
+}
+
+// send all the data, false if the connection is lost
+static bool ntrip_server_send(int sock, const uint8_t *data, size_t len)
+{
+    while (len > 0)
+    {
+        int sent = send(sock, data, len, 0);
+        ERROR_IF(sent <= 0,
+                 return false,
+                 "Cannot send to caster, errno %d", errno);
+        data += sent;
+        len -= sent;
+    }
+    return true;
+}
+
+// HTTP chunk header: the data size in hex, then CRLF
+static size_t chunk_header(char *buffer, size_t len)
+{
+    return sprintf(buffer, "%X\r\n", (unsigned int)len);
+}
+
+// the collected frames are sent in one write, as one chunk in NTRIP v2
+static bool ntrip_server_flush(int sock)
+{
+    if (epoch_len == 0)
+    {
+        return true;
+    }
+
+    uint8_t *start = epoch + CHUNK_HEADER_LEN;
+    size_t len = epoch_len;
+    if (is_v2)
+    {
+        char header[CHUNK_HEADER_LEN + 1];
+        size_t n = chunk_header(header, epoch_len);
+        start -= n;
+        memcpy(start, header, n);
+        memcpy(start + n + epoch_len, "\r\n", CHUNK_TRAILER_LEN);
+        len += n + CHUNK_TRAILER_LEN;
+    }
+
+    epoch_len = 0;
+    return ntrip_server_send(sock, start, len);
+}
+
+static int ntrip_server_connect(const char *host, int port)
+{
+    char service[8];
+    struct addrinfo hints = {
+        .ai_family = AF_INET,
+        .ai_socktype = SOCK_STREAM,
+    };
+    struct addrinfo *res = NULL;
+
+    snprintf(service, sizeof(service), "%d", port);
+    int err = getaddrinfo(host, service, &hints, &res);
+    ERROR_IF(err != 0 || res == NULL,
+             return -1,
+             "Cannot resolve %s", host);
+
+    int sock = socket(res->ai_family, res->ai_socktype, 0);
+    ERROR_IF(sock < 0,
+             freeaddrinfo(res);
+             return -1,
+             "Cannot create socket");
+
+    struct timeval timeout = {.tv_sec = SOCKET_TIMEOUT_S};
+    setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    err = connect(sock, res->ai_addr, res->ai_addrlen);
+    freeaddrinfo(res);
+    ERROR_IF(err != 0,
+             close(sock);
+             return -1,
+             "Cannot connect to %s:%d", host, port);
+
+    return sock;
+}
+
+// send the SOURCE or POST request and check the caster response
+static bool ntrip_server_handshake(int sock, const char *host, int port)
+{
+    char *request = calloc(REQUEST_LEN, sizeof(char));
+    ERROR_IF(request == NULL,
+             return false,
+             "Cannot allocate request");
+
+    char *mnt = config_get(CONFIG_NTRIP_SRV_MNT);
+    char *pwd = config_get(CONFIG_NTRIP_SRV_PWD);
+    if (is_v2)
+    {
+        char credential[CREDENTIAL_LEN];
+        unsigned char basic[CREDENTIAL_LEN * 4 / 3 + 4];
+        size_t basic_len = 0;
+        snprintf(credential, sizeof(credential), "%s:%s", config_get(CONFIG_NTRIP_SRV_USER), pwd);
+        mbedtls_base64_encode(basic, sizeof(basic), &basic_len, (unsigned char *)credential, strlen(credential));
+        basic[basic_len] = '\0';
+        snprintf(request, REQUEST_LEN, POST_REQUEST, mnt, host, port, basic);
+    }
+    else
+    {
+        snprintf(request, REQUEST_LEN, SOURCE_REQUEST, pwd, mnt);
+    }
+
+    bool ok = ntrip_server_send(sock, (uint8_t *)request, strlen(request));
+    free(request);
+    if (!ok)
+    {
+        return false;
+    }
+
+    // the status line is enough, v1 casters send nothing else
+    char response[RESPONSE_LEN] = {0};
+    size_t len = 0;
+    while (len < sizeof(response) - 1 && strstr(response, "\r\n") == NULL)
+    {
+        int n = recv(sock, response + len, sizeof(response) - 1 - len, 0);
+        ERROR_IF(n <= 0,
+                 return false,
+                 "No response from caster");
+        len += n;
+        response[len] = '\0';
+    }
+
+    ok = strncmp(response, is_v2 ? "HTTP/1.1 200" : "ICY 200", is_v2 ? 12 : 7) == 0;
+    ERROR_IF(!ok,
+             return false,
+             "Caster refused: %.*s", (int)strcspn(response, "\r\n"), response);
+    return true;
+}
+
+// collect the frames written since pos into epochs and send them,
+// return false if the connection is lost
+static bool ntrip_server_read(int sock, fanout_t *fanout, uint32_t *pos)
+{
+    uint32_t head = fanout_head(fanout);
+
+    while (*pos != head)
+    {
+        if (fanout_overrun(fanout, *pos))
+        {
+            ESP_LOGW(TAG, "Overrun, skip to the latest frame");
+            epoch_len = 0;
+            *pos = head;
+            break;
+        }
+
+        uint8_t header[RTCM3_HEADER_LEN];
+        fanout_copy(fanout, *pos, header, RTCM3_HEADER_LEN);
+        size_t len = rtcm3_frame_len(header);
+
+        if (epoch_len + len > EPOCH_LEN_MAX && !ntrip_server_flush(sock))
+        {
+            return false;
+        }
+
+        uint8_t *frame = epoch + CHUNK_HEADER_LEN + epoch_len;
+        fanout_copy(fanout, *pos, frame, len);
+        if (fanout_overrun(fanout, *pos))
+        {
+            continue;
+        }
+        *pos += len;
+        epoch_len += len;
+
+        // an epoch ends at the MSM without the multiple message bit
+        if (rtcm3_msm(rtcm3_msg_type(frame)) && !rtcm3_msm_multiple(frame) && !ntrip_server_flush(sock))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// push the receiver output until the connection is lost
+static void ntrip_server_stream(int sock, fanout_t *fanout)
+{
+    uint32_t pos = fanout_head(fanout);
+    uint8_t discard[16];
+
+    epoch_len = 0;
+    ulTaskNotifyTake(pdTRUE, 0);
+
+    while (true)
+    {
+        // frames after the last MSM are sent when the burst ends
+        TickType_t timeout = pdMS_TO_TICKS(epoch_len ? EPOCH_GAP_MS : IDLE_CHECK_MS);
+        if (ulTaskNotifyTake(pdTRUE, timeout) == 0)
+        {
+            if (epoch_len)
+            {
+                if (!ntrip_server_flush(sock))
+                {
+                    return;
+                }
+                continue;
+            }
+
+            // the caster does not send anything, so a read shows a closed connection
+            int n = recv(sock, discard, sizeof(discard), MSG_DONTWAIT);
+            if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK))
+            {
+                ESP_LOGW(TAG, "Caster closed the connection");
+                return;
+            }
+            continue;
+        }
+
+        if (!ntrip_server_read(sock, fanout, &pos))
+        {
+            return;
+        }
+    }
+}
+
+static void ntrip_server_task(void *args)
+{
+    fanout_t *fanout = uart_rtcm3_fanout();
+    char *host = config_get(CONFIG_NTRIP_SRV_IP);
+    int port = atoi(config_get(CONFIG_NTRIP_SRV_PORT));
+    if (!port)
+        port = 2101;
+    uint32_t backoff = BACKOFF_MIN_MS;
+
+    while (true)
+    {
+        status_set(STATUS_NTRIP_SRV_STATUS, "Connecting");
+        TickType_t start = xTaskGetTickCount();
+
+        int sock = ntrip_server_connect(host, port);
+        if (sock >= 0)
+        {
+            if (ntrip_server_handshake(sock, host, port))
+            {
+                ESP_LOGI(TAG, "Streaming to %s:%d/%s", host, port, config_get(CONFIG_NTRIP_SRV_MNT));
+                status_set(STATUS_NTRIP_SRV_STATUS, "Connected");
+                ntrip_server_stream(sock, fanout);
+            }
+            close(sock);
+        }
+
+        status_set(STATUS_NTRIP_SRV_STATUS, "Disconnected");
+
+        // double the delay on each failure, up to BACKOFF_MAX_MS, until a connection lasts
+        if ((xTaskGetTickCount() - start) * portTICK_PERIOD_MS >= STABLE_MS)
+        {
+            backoff = BACKOFF_MIN_MS;
+        }
+        ESP_LOGI(TAG, "Reconnect in %" PRIu32 " ms", backoff);
+        vTaskDelay(pdMS_TO_TICKS(backoff));
+        backoff = MIN(backoff * 2, BACKOFF_MAX_MS);
+    }
+}
+
+esp_err_t ntrip_server_init()
+{
+    if (strlen(config_get(CONFIG_NTRIP_SRV_IP)) == 0 || strlen(config_get(CONFIG_NTRIP_SRV_MNT)) == 0)
+    {
+        return ESP_OK;
+    }
+
+    is_v2 = strcmp(config_get(CONFIG_NTRIP_SRV_VER), "1") != 0;
+
+    epoch = calloc(CHUNK_HEADER_LEN + EPOCH_LEN_MAX + CHUNK_TRAILER_LEN, sizeof(uint8_t));
+    ERROR_IF(epoch == NULL,
+             return ESP_ERR_NO_MEM,
+             "Cannot allocate epoch buffer");
+
+    ERROR_IF(xTaskCreate(ntrip_server_task, "ntrip_server_task", 4096, NULL, 10, &ntrip_server_task_handle) != pdPASS,
+             return ESP_ERR_NO_MEM,
+             "Cannot create ntrip_server task");
+    ERROR_IF(!fanout_subscribe(uart_rtcm3_fanout(), ntrip_server_notify, NULL),
+             return ESP_FAIL,
+             "Cannot subscribe to RTCM3 output");
+
+    return ESP_OK;
+}
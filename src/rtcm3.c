@@ -0,0 +1,297 @@
+/*
+ * This file is part of the ESP32-GNSS-Base-Station firmware, published
+ * at (https://github.com/vuquangtrong/esp32-gnss-base-station).
+ * Copyright (c) 2023 Vu Quang Trong.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rtcm3.h"
+
+// CRC-24Q lookup table, polynomial 0x1864CFB
+static const uint32_t CRC24Q_TABLE[256] = {
+    0x000000, 0x864CFB, 0x8AD50D, 0x0C99F6, 0x93E6E1, 0x15AA1A, 0x1933EC, 0x9F7F17,
+    0xA18139, 0x27CDC2, 0x2B5434, 0xAD18CF, 0x3267D8, 0xB42B23, 0xB8B2D5, 0x3EFE2E,
+    0xC54E89, 0x430272, 0x4F9B84, 0xC9D77F, 0x56A868, 0xD0E493, 0xDC7D65, 0x5A319E,
+    0x64CFB0, 0xE2834B, 0xEE1ABD, 0x685646, 0xF72951, 0x7165AA, 0x7DFC5C, 0xFBB0A7,
+    0x0CD1E9, 0x8A9D12, 0x8604E4, 0x00481F, 0x9F3708, 0x197BF3, 0x15E205, 0x93AEFE,
+    0xAD50D0, 0x2B1C2B, 0x2785DD, 0xA1C926, 0x3EB631, 0xB8FACA, 0xB4633C, 0x322FC7,
+    0xC99F60, 0x4FD39B, 0x434A6D, 0xC50696, 0x5A7981, 0xDC357A, 0xD0AC8C, 0x56E077,
+    0x681E59, 0xEE52A2, 0xE2CB54, 0x6487AF, 0xFBF8B8, 0x7DB443, 0x712DB5, 0xF7614E,
+    0x19A3D2, 0x9FEF29, 0x9376DF, 0x153A24, 0x8A4533, 0x0C09C8, 0x00903E, 0x86DCC5,
+    0xB822EB, 0x3E6E10, 0x32F7E6, 0xB4BB1D, 0x2BC40A, 0xAD88F1, 0xA11107, 0x275DFC,
+    0xDCED5B, 0x5AA1A0, 0x563856, 0xD074AD, 0x4F0BBA, 0xC94741, 0xC5DEB7, 0x43924C,
+    0x7D6C62, 0xFB2099, 0xF7B96F, 0x71F594, 0xEE8A83, 0x68C678, 0x645F8E, 0xE21375,
+    0x15723B, 0x933EC0, 0x9FA736, 0x19EBCD, 0x8694DA, 0x00D821, 0x0C41D7, 0x8A0D2C,
+    0xB4F302, 0x32BFF9, 0x3E260F, 0xB86AF4, 0x2715E3, 0xA15918, 0xADC0EE, 0x2B8C15,
+    0xD03CB2, 0x567049, 0x5AE9BF, 0xDCA544, 0x43DA53, 0xC596A8, 0xC90F5E, 0x4F43A5,
+    0x71BD8B, 0xF7F170, 0xFB6886, 0x7D247D, 0xE25B6A, 0x641791, 0x688E67, 0xEEC29C,
+    0x3347A4, 0xB50B5F, 0xB992A9, 0x3FDE52, 0xA0A145, 0x26EDBE, 0x2A7448, 0xAC38B3,
+    0x92C69D, 0x148A66, 0x181390, 0x9E5F6B, 0x01207C, 0x876C87, 0x8BF571, 0x0DB98A,
+    0xF6092D, 0x7045D6, 0x7CDC20, 0xFA90DB, 0x65EFCC, 0xE3A337, 0xEF3AC1, 0x69763A,
+    0x578814, 0xD1C4EF, 0xDD5D19, 0x5B11E2, 0xC46EF5, 0x42220E, 0x4EBBF8, 0xC8F703,
+    0x3F964D, 0xB9DAB6, 0xB54340, 0x330FBB, 0xAC70AC, 0x2A3C57, 0x26A5A1, 0xA0E95A,
+    0x9E1774, 0x185B8F, 0x14C279, 0x928E82, 0x0DF195, 0x8BBD6E, 0x872498, 0x016863,
+    0xFAD8C4, 0x7C943F, 0x700DC9, 0xF64132, 0x693E25, 0xEF72DE, 0xE3EB28, 0x65A7D3,
+    0x5B59FD, 0xDD1506, 0xD18CF0, 0x57C00B, 0xC8BF1C, 0x4EF3E7, 0x426A11, 0xC426EA,
+    0x2AE476, 0xACA88D, 0xA0317B, 0x267D80, 0xB90297, 0x3F4E6C, 0x33D79A, 0xB59B61,
+    0x8B654F, 0x0D29B4, 0x01B042, 0x87FCB9, 0x1883AE, 0x9ECF55, 0x9256A3, 0x141A58,
+    0xEFAAFF, 0x69E604, 0x657FF2, 0xE33309, 0x7C4C1E, 0xFA00E5, 0xF69913, 0x70D5E8,
+    0x4E2BC6, 0xC8673D, 0xC4FECB, 0x42B230, 0xDDCD27, 0x5B81DC, 0x57182A, 0xD154D1,
+    0x26359F, 0xA07964, 0xACE092, 0x2AAC69, 0xB5D37E, 0x339F85, 0x3F0673, 0xB94A88,
+    0x87B4A6, 0x01F85D, 0x0D61AB, 0x8B2D50, 0x145247, 0x921EBC, 0x9E874A, 0x18CBB1,
+    0xE37B16, 0x6537ED, 0x69AE1B, 0xEFE2E0, 0x709DF7, 0xF6D10C, 0xFA48FA, 0x7C0401,
+    0x42FA2F, 0xC4B6D4, 0xC82F22, 0x4E63D9, 0xD11CCE, 0x575035, 0x5BC9C3, 0xDD8538
+};
+
+uint32_t rtcm3_crc24q(const uint8_t *data, size_t len)
+{
+    uint32_t crc = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        crc = ((crc << 8) & 0xFFFFFF) ^ CRC24Q_TABLE[(crc >> 16) ^ data[i]];
+    }
+    return crc;
+}
+
+// header = preamble (8 bits), reserved (6 bits), payload length (10 bits)
+size_t rtcm3_frame_len(const uint8_t *header)
+{
+    return RTCM3_HEADER_LEN + (((header[1] & 0x03) << 8) | header[2]) + RTCM3_CRC_LEN;
+}
+
+// message number is the first 12 bits of the payload
+uint16_t rtcm3_msg_type(const uint8_t *frame)
+{
+    return (frame[3] << 4) | (frame[4] >> 4);
+}
+
+// MSM1 to MSM7 of GPS, GLONASS, Galileo, SBAS, QZSS, BeiDou and NavIC
+bool rtcm3_msm(uint16_t type)
+{
+    return type >= 1071 && type <= 1137 && type % 10 >= 1 && type % 10 <= 7;
+}
+
+// MSM header = type (12 bits), station (12 bits), epoch time (30 bits), multiple message bit,
+// the bit is set on every MSM of an epoch but the last one
+bool rtcm3_msm_multiple(const uint8_t *frame)
+{
+    if (!rtcm3_msm(rtcm3_msg_type(frame)) || rtcm3_frame_len(frame) < RTCM3_HEADER_LEN + 7 + RTCM3_CRC_LEN)
+    {
+        return false;
+    }
+    return (frame[RTCM3_HEADER_LEN + 6] & 0x02) != 0;
+}
+
+// GNSS epoch time of an MSM, in the time scale of its constellation
+uint32_t rtcm3_msm_epoch(const uint8_t *frame)
+{
+    const uint8_t *payload = frame + RTCM3_HEADER_LEN;
+    return (((uint32_t)payload[3] << 24) | (payload[4] << 16) | (payload[5] << 8) | payload[6]) >> 2;
+}
+
+static bool rtcm3_check_crc(const uint8_t *frame, size_t len)
+{
+    uint32_t crc = rtcm3_crc24q(frame, len - RTCM3_CRC_LEN);
+    return frame[len - 3] == ((crc >> 16) & 0xFF) &&
+           frame[len - 2] == ((crc >> 8) & 0xFF) &&
+           frame[len - 1] == (crc & 0xFF);
+}
+
+// drop n bytes from the collected data, then align on the next preamble
+static size_t rtcm3_parser_skip(rtcm3_parser_t *parser, size_t n)
+{
+    uint8_t *p = NULL;
+    if (n < parser->len)
+    {
+        p = memchr(parser->frame + n, RTCM3_PREAMBLE, parser->len - n);
+    }
+
+    size_t skip = p ? (size_t)(p - parser->frame) : parser->len;
+    parser->len -= skip;
+    memmove(parser->frame, parser->frame + skip, parser->len);
+    parser->frame_len = 0;
+    return skip - n;
+}
+
+// emit every complete frame held in the collected data
+static size_t rtcm3_parser_process(rtcm3_parser_t *parser, rtcm3_frame_cb_t cb, void *ctx)
+{
+    size_t frames = 0;
+
+    while (parser->len >= RTCM3_HEADER_LEN)
+    {
+        if (parser->frame_len == 0)
+        {
+            // reserved bits must be zero, otherwise it is not a real preamble
+            if (parser->frame[1] & 0xFC)
+            {
+                parser->dropped_bytes += rtcm3_parser_skip(parser, 1) + 1;
+                continue;
+            }
+            parser->frame_len = rtcm3_frame_len(parser->frame);
+        }
+
+        if (parser->len < parser->frame_len)
+        {
+            break;
+        }
+
+        if (rtcm3_check_crc(parser->frame, parser->frame_len))
+        {
+            if (cb)
+            {
+                cb(parser->frame, parser->frame_len, ctx);
+            }
+            frames++;
+            parser->dropped_bytes += rtcm3_parser_skip(parser, parser->frame_len);
+        }
+        else
+        {
+            // resync from the byte after this false preamble
+            parser->crc_errors++;
+            parser->dropped_bytes += rtcm3_parser_skip(parser, 1) + 1;
+        }
+    }
+
+    return frames;
+}
+
+void rtcm3_parser_init(rtcm3_parser_t *parser)
+{
+    memset(parser, 0, sizeof(rtcm3_parser_t));
+}
+
+// number of bytes which completes the current header or frame
+size_t rtcm3_parser_wanted(const rtcm3_parser_t *parser)
+{
+    if (parser->frame_len == 0)
+    {
+        return RTCM3_HEADER_LEN - parser->len;
+    }
+    return parser->frame_len - parser->len;
+}
+
+// feed a chunk of the stream, return the number of emitted frames
+size_t rtcm3_parser_feed(rtcm3_parser_t *parser, const uint8_t *data, size_t len, rtcm3_frame_cb_t cb, void *ctx)
+{
+    size_t frames = 0;
+
+    while (len > 0)
+    {
+        // hunt for a preamble
+        if (parser->len == 0)
+        {
+            const uint8_t *p = memchr(data, RTCM3_PREAMBLE, len);
+            size_t skip = p ? (size_t)(p - data) : len;
+            parser->dropped_bytes += skip;
+            data += skip;
+            len -= skip;
+            if (len == 0)
+            {
+                break;
+            }
+        }
+
+        // only take what the current header or frame needs
+        size_t n = rtcm3_parser_wanted(parser);
+        if (n > len)
+        {
+            n = len;
+        }
+        memcpy(parser->frame + parser->len, data, n);
+        parser->len += n;
+        data += n;
+        len -= n;
+
+        frames += rtcm3_parser_process(parser, cb, ctx);
+    }
+
+    return frames;
+}
+
+// return false if the filter text is not valid, the filter is then empty
+bool rtcm3_filter_parse(rtcm3_filter_t *filter, const char *s)
+{
+    char *end;
+
+    memset(filter, 0, sizeof(rtcm3_filter_t));
+    while (*s)
+    {
+        unsigned long type = strtoul(s, &end, 10);
+        unsigned long decimation = 1;
+        if (end == s || type > 4095 || filter->count == RTCM3_FILTER_TYPES_MAX)
+        {
+            break;
+        }
+        s = end;
+
+        if (*s == ':')
+        {
+            decimation = strtoul(s + 1, &end, 10);
+            if (end == s + 1 || decimation == 0 || decimation > UINT16_MAX)
+            {
+                break;
+            }
+            s = end;
+        }
+
+        filter->type[filter->count] = type;
+        filter->decimation[filter->count] = decimation;
+        filter->count++;
+
+        // a comma must be followed by another type
+        if (*s == ',' && s[1] != '\0')
+        {
+            s++;
+        }
+        else if (*s != '\0')
+        {
+            break;
+        }
+    }
+
+    if (*s != '\0')
+    {
+        memset(filter, 0, sizeof(rtcm3_filter_t));
+        return false;
+    }
+    return true;
+}
+
+// decide on one frame of the given type, counts frames for decimation
+bool rtcm3_filter_pass(rtcm3_filter_t *filter, uint16_t type)
+{
+    if (filter->count == 0)
+    {
+        return true;
+    }
+
+    for (size_t i = 0; i < filter->count; i++)
+    {
+        if (filter->type[i] == type)
+        {
+            bool pass = filter->counter[i] == 0;
+            if (++filter->counter[i] >= filter->decimation[i])
+            {
+                filter->counter[i] = 0;
+            }
+            return pass;
+        }
+    }
+    return false;
+}
@@ -15,11 +15,14 @@
  * You should have received a copy of the GNU General Public License
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
+#include <stdlib.h>
 #include <string.h>
+#include <inttypes.h>
 #include <driver/uart.h>
 #include <driver/gpio.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <freertos/semphr.h>
 #include <esp_err.h>
 #include <esp_event.h>
 
@@ -27,15 +30,50 @@
 #include "config.h"
 #include "status.h"
 #include "ublox.h"
+#include "ubx_profiles.h"
+#include "rtcm3.h"
+#include "nmea.h"
+#include "fanout.h"
 #include "uart.h"
 
 #define UART_STATUS_BUFFER_LEN 4096
+#define UART_STATUS_QUEUE_LEN 16
 #define UART_RTCM3_BUFFER_LEN 8192
+#define UART_RTCM3_FANOUT_LEN 16384
 #define UBX_MSG_LEN 128
+#define UART_PROBE_BUFFER_LEN 256
+#define UART_PROBE_TIMEOUT_MS 500
+#define UART_SWITCH_DELAY_MS 100
+#define UART_BAUDRATE_DEFAULT 38400
+#define UART_BAUDRATE_MAX 921600
+#define UART_SCAN_RETRIES 3
+#define UBX_PENDING_MAX 4
+#define UBX_ACK_TIMEOUT_MS 500
+#define UBX_ACK_RETRIES 2
+#define UBX_TMODE_POS_MAX (INT32_MAX * 100LL) // 0.1 mm, the standard keys are I4 in cm
 
 static const char *TAG = "UART";
 
-ESP_EVENT_DEFINE_BASE(UART_RTCM3_EVENT_READ);
+// a command waiting for UBX-ACK-ACK or UBX-ACK-NAK
+typedef struct ubx_pending_t
+{
+    bool used;
+    uint8_t cls;
+    uint8_t id;
+    uint32_t seq; // answers come in the order of the commands
+    ubx_ack_t result;
+    SemaphoreHandle_t done;
+} ubx_pending_t;
+
+static ubx_pending_t ubx_pending[UBX_PENDING_MAX];
+static uint32_t ubx_pending_seq = 0;
+static portMUX_TYPE ubx_pending_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// rates supported by the receiver UARTs, fastest first
+static const uint32_t UART_BAUDRATES[] = {921600, 460800, 230400, 115200, 57600, 38400, 19200, 9600};
+
+// validated RTCM3 frames from UART_RTCM3, shared by all consumers
+static fanout_t *rtcm3_fanout = NULL;
 #ifdef BOARD_ESP32_XBEE
 // UART0 is connected to U-blox UART2, for sending or reading RTCM3
 // This UART0 port is also connected to USB-VCOM for upload firmware
@@ -59,6 +97,13 @@ const uart_config_t UART_RTCM3_CONFIG = {
 };
 
 ESP_EVENT_DEFINE_BASE(UART_STATUS_EVENT_READ);
+static QueueHandle_t uart_status_queue = NULL;
+
+// latest navigation messages from UART_STATUS
+static portMUX_TYPE uart_nav_lock = portMUX_INITIALIZER_UNLOCKED;
+static ubx_nav_pvt_t uart_nav_pvt;
+static ubx_nav_hpposllh_t uart_nav_hpposllh;
+static ubx_nav_svin_t uart_nav_svin;
 #ifdef BOARD_ESP32_XBEE
 // UART1 is connected to U-blox UART1, for sending CFG, and reading GGA
 const uart_port_t UART_STATUS_PORT = UART_NUM_1;
@@ -90,216 +135,455 @@ void uart_unregister_handler(esp_event_base_t event_base, esp_event_handler_t ev
     esp_event_handler_unregister(event_base, ESP_EVENT_ANY_ID, event_handler);
 }
 
-void ubx_set_default()
+fanout_t *uart_rtcm3_fanout()
 {
-    uint8_t *buffer = calloc(32, sizeof(uint8_t));
-    uint32_t n;
+    return rtcm3_fanout;
+}
 
-    /*
-     * UART 1
-     */
-    // NMEA ouput is enabled by default; only keep GGA, GST; disable GLL, GSA, GSV, RMC, VTG, TXT
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-MSGOUT-NMEA_ID_GGA_UART1 1", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-MSGOUT-NMEA_ID_GST_UART1 1", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-MSGOUT-NMEA_ID_GLL_UART1 0", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-MSGOUT-NMEA_ID_GSA_UART1 0", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-MSGOUT-NMEA_ID_GSV_UART1 0", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-MSGOUT-NMEA_ID_RMC_UART1 0", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-MSGOUT-NMEA_ID_VTG_UART1 0", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-MSGOUT-NMEA_ID_TXT_UART1 0", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
+void uart_get_nav_pvt(ubx_nav_pvt_t *pvt)
+{
+    portENTER_CRITICAL(&uart_nav_lock);
+    memcpy(pvt, &uart_nav_pvt, sizeof(ubx_nav_pvt_t));
+    portEXIT_CRITICAL(&uart_nav_lock);
+}
 
-    // Enable High Precision mode
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-NMEA-HIGHPREC 1", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
+void uart_get_nav_hpposllh(ubx_nav_hpposllh_t *pos)
+{
+    portENTER_CRITICAL(&uart_nav_lock);
+    memcpy(pos, &uart_nav_hpposllh, sizeof(ubx_nav_hpposllh_t));
+    portEXIT_CRITICAL(&uart_nav_lock);
+}
 
-    // RTCM3 input/output should be disabled
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-UART1INPROT-RTCM3X 0", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-UART1OUTPROT-RTCM3X 0", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
+void uart_get_nav_svin(ubx_nav_svin_t *svin)
+{
+    portENTER_CRITICAL(&uart_nav_lock);
+    memcpy(svin, &uart_nav_svin, sizeof(ubx_nav_svin_t));
+    portEXIT_CRITICAL(&uart_nav_lock);
+}
 
-    /*
-     * UART 2
-     */
-    // Set Baudraet
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-UART2-BAUDRATE 115200", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
+// the probes report through a ubx_ack_t: a MON-VER answer counts as an ACK
+static void uart_probe_handler(uint8_t cls, uint8_t id, const uint8_t *payload, size_t len, void *ctx)
+{
+    if (cls == UBX_CLASS_MON && id == UBX_ID_MON_VER)
+    {
+        *(ubx_ack_t *)ctx = UBX_ACK_ACK;
+    }
+}
 
-    // NMEA input and NMEA output are disabled by default
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-UART2OUTPROT-NMEA 0", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
+static void uart_probe_ack_handler(uint8_t cls, uint8_t id, const uint8_t *payload, size_t len, void *ctx)
+{
+    if (cls == UBX_CLASS_ACK && len >= 2 && payload[0] == UBX_CLASS_CFG && payload[1] == UBX_ID_CFG_VALSET)
+    {
+        *(ubx_ack_t *)ctx = id == UBX_ID_ACK_ACK ? UBX_ACK_ACK : UBX_ACK_NAK;
+    }
+}
 
-    // UBX input is enabled, UBX output is disabled by default
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-UART2OUTPROT-UBX 0", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
+// write a UBX frame, then read the port until the handler sets the result or the timeout ends,
+// this runs before uart_status_task starts so the answer is read here
+static ubx_ack_t uart_probe_exchange(uart_port_t port, uint8_t *buffer, size_t len, ubx_frame_cb_t handler)
+{
+    ubx_parser_t *parser = calloc(1, sizeof(ubx_parser_t));
+    TickType_t start = xTaskGetTickCount();
+    ubx_ack_t result = UBX_ACK_PENDING;
+    int32_t n;
 
-    // RTCM3 input and RTCM3 output are enabled by default
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-UART2OUTPROT-RTCM3X 0", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
+    ERROR_IF(parser == NULL,
+             return UBX_ACK_TIMEOUT,
+             "Cannot allocate probe parser");
 
-    // default measurement rate is 1 Hz
-    // n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-RATE-MEAS 1", buffer);
-    // uart_write_bytes(UART_STATUS_PORT, buffer, n);
+    uart_flush_input(port);
+    ubx_parser_init(parser);
+    uart_write_bytes(port, buffer, len);
 
-    // set output rate of recommended RTCM3 messages
-    //// RTCM 1005 Stationary RTK reference station ARP
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-MSGOUT-RTCM_3X_TYPE1005_UART2 1", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
-    //// RTCM 1074 GPS MSM4
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-MSGOUT-RTCM_3X_TYPE1074_UART2 1", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
-    //// RTCM 1084 GLONASS MSM4
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-MSGOUT-RTCM_3X_TYPE1084_UART2 1", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
-    //// RTCM 1094 Galileo MSM4
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-MSGOUT-RTCM_3X_TYPE1094_UART2 1", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
-    //// RTCM 1124 BeiDou MSM4
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-MSGOUT-RTCM_3X_TYPE1124_UART2 1", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
-    //// RTCM 1230 GLONASS code-phase biases
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-MSGOUT-RTCM_3X_TYPE1230_UART2 1", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
+    // the answer may come between NMEA or RTCM3 data
+    while (result == UBX_ACK_PENDING && (xTaskGetTickCount() - start) < pdMS_TO_TICKS(UART_PROBE_TIMEOUT_MS))
+    {
+        n = uart_read_bytes(port, buffer, UART_PROBE_BUFFER_LEN, pdMS_TO_TICKS(20));
+        if (n > 0)
+        {
+            ubx_parser_feed(parser, buffer, n, handler, &result);
+        }
+    }
 
-    /*
-     * MODE
-     */
-    // default in rover mode
-    ubx_set_mode_rover();
+    free(parser);
+    return result == UBX_ACK_PENDING ? UBX_ACK_TIMEOUT : result;
+}
+
+// switch the port to the rate, then check that the receiver answers a UBX poll on it
+static bool uart_probe(uart_port_t port, uint32_t baudrate)
+{
+    uint8_t *buffer = calloc(UART_PROBE_BUFFER_LEN, sizeof(uint8_t));
+    ubx_ack_t result;
+
+    ERROR_IF(buffer == NULL,
+             return false,
+             "Cannot allocate probe buffer");
+
+    uart_set_baudrate(port, baudrate);
+    result = uart_probe_exchange(port, buffer, ubx_gen_poll(UBX_CLASS_MON, UBX_ID_MON_VER, buffer), uart_probe_handler);
 
     free(buffer);
+    return result == UBX_ACK_ACK;
 }
 
-void ubx_set_mode_rover()
+// send a CFG-VALSET through UART_STATUS and read its ACK, retried on timeout
+static bool uart_probe_valset(const char *msg)
 {
-    uint8_t *buffer = calloc(32, sizeof(uint8_t));
-    uint32_t n;
+    uint8_t *buffer = calloc(UART_PROBE_BUFFER_LEN, sizeof(uint8_t));
+    ubx_ack_t result = UBX_ACK_TIMEOUT;
 
-    // TMODE Disabled
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-TMODE-MODE 0", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
+    ERROR_IF(buffer == NULL,
+             return false,
+             "Cannot allocate probe buffer");
 
-    // Disable RTCM3 output on UART2
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-UART2OUTPROT-RTCM3X 0", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
+    for (uint8_t attempt = 0; attempt <= UBX_ACK_RETRIES && result == UBX_ACK_TIMEOUT; attempt++)
+    {
+        result = uart_probe_exchange(UART_STATUS_PORT, buffer, ubx_gen_cmd(msg, buffer, UART_PROBE_BUFFER_LEN), uart_probe_ack_handler);
+    }
 
     free(buffer);
+    ERROR_IF(result != UBX_ACK_ACK,
+             return false,
+             "Receiver does not accept %s", msg);
 
-    vTaskDelay(pdMS_TO_TICKS(1000));
+    return true;
+}
 
-    status_set(STATUS_GNSS_MODE, "Rover");
+// find the rate the receiver uses now: the saved one, the factory default, then all others
+static uint32_t uart_scan(uart_port_t port, uint32_t saved)
+{
+    if (saved > 0 && uart_probe(port, saved))
+    {
+        return saved;
+    }
+
+    if (saved != UART_BAUDRATE_DEFAULT && uart_probe(port, UART_BAUDRATE_DEFAULT))
+    {
+        return UART_BAUDRATE_DEFAULT;
+    }
+
+    for (size_t i = 0; i < sizeof(UART_BAUDRATES) / sizeof(UART_BAUDRATES[0]); i++)
+    {
+        if (UART_BAUDRATES[i] != saved && UART_BAUDRATES[i] != UART_BAUDRATE_DEFAULT &&
+            uart_probe(port, UART_BAUDRATES[i]))
+        {
+            return UART_BAUDRATES[i];
+        }
+    }
+
+    return 0;
 }
 
-void ubx_set_mode_survey(const char *dur, const char *acc)
+// set a receiver UART rate in the given layers, the command always goes through UART_STATUS,
+// a change in RAM switches the receiver at once, BBR only keeps the rate for its next start
+static void uart_set_receiver_baudrate(const char *key, uint32_t baudrate, uint8_t layers)
 {
-    uint8_t *buffer = calloc(32, sizeof(uint8_t));
+    char *msg = calloc(UBX_MSG_LEN, sizeof(char));
+    uint8_t *buffer = calloc(UBX_MSG_LEN, sizeof(uint8_t));
     uint32_t n;
 
-    // Survey in 5 mins = 300 seconds
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-TMODE-SVIN_MIN_DUR 300", buffer);
+    sprintf(msg, "CFG-VALSET 0 %u 0 0 %s %" PRIu32, layers, key, baudrate);
+    n = ubx_gen_cmd(msg, buffer, UBX_MSG_LEN);
     uart_write_bytes(UART_STATUS_PORT, buffer, n);
+    uart_wait_tx_done(UART_STATUS_PORT, pdMS_TO_TICKS(UART_SWITCH_DELAY_MS));
 
-    // Accuracy in 5000 x 0.1 = 500 mm = 50 cm
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-TMODE-SVIN_ACC_LIMIT 5000", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
+    // the receiver finishes its output at the old rate before switching
+    if (layers & UBX_LAYER_RAM)
+    {
+        vTaskDelay(pdMS_TO_TICKS(UART_SWITCH_DELAY_MS));
+    }
 
-    // TMODE Enabled in Survey-in mode
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-TMODE-MODE 1", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
+    free(buffer);
+    free(msg);
+}
 
-    // Enable RTCM3 output on UART2
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-UART2OUTPROT-RTCM3X 1", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
+// move a receiver UART and the matching ESP32 port to the fastest rate which works,
+// the working rate is saved so that the next boot goes straight to it
+static uint32_t uart_negotiate(uart_port_t port, const char *key, config_t config)
+{
+    uint32_t saved = atoi(config_get(config));
+    uint32_t current = 0;
+    char value[12];
 
-    free(buffer);
+    // the receiver may still be booting, the probe timeouts pace the retries
+    for (int i = 0; i < UART_SCAN_RETRIES && current == 0; i++)
+    {
+        current = uart_scan(port, saved);
+    }
+
+    ERROR_IF(current == 0,
+             uart_set_baudrate(port, UART_BAUDRATE_DEFAULT);
+             return 0,
+             "No answer from receiver on %s", key);
+
+    for (size_t i = 0; i < sizeof(UART_BAUDRATES) / sizeof(UART_BAUDRATES[0]) && UART_BAUDRATES[i] > current; i++)
+    {
+        if (UART_BAUDRATES[i] > UART_BAUDRATE_MAX)
+        {
+            continue;
+        }
+
+        uart_set_receiver_baudrate(key, UART_BAUDRATES[i], UBX_LAYER_RAM);
+        if (uart_probe(port, UART_BAUDRATES[i]))
+        {
+            current = UART_BAUDRATES[i];
+            break;
+        }
 
-    vTaskDelay(pdMS_TO_TICKS(1000));
+        ESP_LOGW(TAG, "%s %" PRIu32 " does not work, fall back to %" PRIu32, key, UART_BAUDRATES[i], current);
 
-    status_set(STATUS_GNSS_MODE, "Base-Survey");
+        // the receiver may have switched even if the link does not work at the new rate
+        uart_set_receiver_baudrate(key, current, UBX_LAYER_RAM);
+        if (!uart_probe(port, current))
+        {
+            current = uart_scan(port, current);
+            ERROR_IF(current == 0,
+                     uart_set_baudrate(port, UART_BAUDRATE_DEFAULT);
+                     return 0,
+                     "Lost receiver on %s", key);
+        }
+    }
+
+    // rates are tried in RAM only, a failed one is gone after a power cycle,
+    // the working one goes to BBR so that the receiver starts at the saved rate
+    uart_set_receiver_baudrate(key, current, UBX_LAYER_BBR);
+
+    ESP_LOGI(TAG, "%s %" PRIu32, key, current);
+    if (current != saved)
+    {
+        sprintf(value, "%" PRIu32, current);
+        config_set(config, value);
+    }
+
+    return current;
 }
 
-static void set_msg_with_val_scale(char *buffer, const char *msg, const char *val, int scale)
+// called from uart_status_task, complete the oldest command of that class and id
+static void ubx_ack_received(uint8_t cls, uint8_t id, ubx_ack_t result)
 {
-    char *p;
-    int s;
-    int l = strlen(msg);
+    ubx_pending_t *pending = NULL;
 
-    p = strstr(val, ".");
-    s = p - val;
+    portENTER_CRITICAL(&ubx_pending_lock);
+    for (size_t i = 0; i < UBX_PENDING_MAX; i++)
+    {
+        if (ubx_pending[i].used && ubx_pending[i].result == UBX_ACK_PENDING &&
+            ubx_pending[i].cls == cls && ubx_pending[i].id == id &&
+            (pending == NULL || (int32_t)(ubx_pending[i].seq - pending->seq) < 0))
+        {
+            pending = &ubx_pending[i];
+        }
+    }
+    if (pending)
+    {
+        pending->result = result;
+    }
+    portEXIT_CRITICAL(&ubx_pending_lock);
 
-    strcpy(buffer, msg);
-    strncpy(buffer + l, val, s);
-    strncpy(buffer + l + s, val + s + 1, scale);
+    if (pending)
+    {
+        xSemaphoreGive(pending->done);
+    }
 }
 
-void ubx_set_mode_fixed(const char *lat, const char *lon, const char *alt)
+static ubx_ack_t ubx_wait_ack(ubx_pending_t *pending, uint32_t timeout_ms)
 {
-    char *msg = calloc(UBX_MSG_LEN, sizeof(char));
-    uint8_t *buffer = calloc(UBX_MSG_LEN, sizeof(uint8_t));
-    uint32_t n;
+    TickType_t start = xTaskGetTickCount();
+    TickType_t timeout = pdMS_TO_TICKS(timeout_ms);
+    TickType_t elapsed;
 
-    // POS LLH
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-TMODE-POS_TYPE 1", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
+    // a signal without a result is a late answer for a previous user of this slot
+    while ((elapsed = xTaskGetTickCount() - start) < timeout &&
+           xSemaphoreTake(pending->done, timeout - elapsed) == pdTRUE)
+    {
+        if (pending->result != UBX_ACK_PENDING)
+        {
+            return pending->result;
+        }
+    }
+    return UBX_ACK_TIMEOUT;
+}
 
-    // LAT in scale of 10^-7
-    memset(msg, 0, UBX_MSG_LEN);
-    set_msg_with_val_scale(msg, "CFG-VALSET 0 1 0 0 CFG-TMODE-LAT ", lat, 7);
-    n = ubx_gen_cmd(msg, buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
+// send a command on UART_STATUS and wait until the receiver answers it,
+// a command without answer is sent again up to retries times, a rejected one is not
+esp_err_t ubx_send_cmd(const uint8_t *frame, size_t len, uint32_t timeout_ms, uint8_t retries)
+{
+    ubx_pending_t *pending = NULL;
+    ubx_ack_t result = UBX_ACK_TIMEOUT;
 
-    memset(msg, 0, UBX_MSG_LEN);
-    sprintf(msg, "CFG-VALSET 0 1 0 0 CFG-TMODE-LAT_HP %s", &lat[strlen(lat) - 2]);
-    n = ubx_gen_cmd(msg, buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
+    ERROR_IF(len < UBX_HEADER_LEN + UBX_CHECKSUM_LEN,
+             return ESP_ERR_INVALID_ARG,
+             "Invalid UBX command");
 
-    // LON in scale of 10^-7
-    memset(msg, 0, UBX_MSG_LEN);
-    set_msg_with_val_scale(msg, "CFG-VALSET 0 1 0 0 CFG-TMODE-LON ", lon, 7);
-    n = ubx_gen_cmd(msg, buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
+    portENTER_CRITICAL(&ubx_pending_lock);
+    for (size_t i = 0; i < UBX_PENDING_MAX; i++)
+    {
+        if (!ubx_pending[i].used)
+        {
+            pending = &ubx_pending[i];
+            pending->used = true;
+            pending->cls = frame[2];
+            pending->id = frame[3];
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&ubx_pending_lock);
 
-    memset(msg, 0, UBX_MSG_LEN);
-    sprintf(msg, "CFG-VALSET 0 1 0 0 CFG-TMODE-LON_HP %s", &lon[strlen(lon) - 2]);
-    n = ubx_gen_cmd(msg, buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
+    ERROR_IF(pending == NULL,
+             return ESP_ERR_NO_MEM,
+             "Too many UBX commands in flight");
 
-    // HEIGHT in cm
-    memset(msg, 0, UBX_MSG_LEN);
-    set_msg_with_val_scale(msg, "CFG-VALSET 0 1 0 0 CFG-TMODE-HEIGHT ", alt, 2);
-    n = ubx_gen_cmd(msg, buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
+    for (uint8_t attempt = 0; attempt <= retries && result == UBX_ACK_TIMEOUT; attempt++)
+    {
+        portENTER_CRITICAL(&ubx_pending_lock);
+        pending->result = UBX_ACK_PENDING;
+        pending->seq = ubx_pending_seq++;
+        portEXIT_CRITICAL(&ubx_pending_lock);
 
-    memset(msg, 0, UBX_MSG_LEN);
-    sprintf(msg, "CFG-VALSET 0 1 0 0 CFG-TMODE-HEIGHT_HP %s0", &alt[strlen(alt) - 1]);
-    n = ubx_gen_cmd(msg, buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
+        uart_write_bytes(UART_STATUS_PORT, frame, len);
+        result = ubx_wait_ack(pending, timeout_ms);
+    }
+
+    portENTER_CRITICAL(&ubx_pending_lock);
+    pending->used = false;
+    portEXIT_CRITICAL(&ubx_pending_lock);
+
+    ERROR_IF(result == UBX_ACK_NAK,
+             return ESP_FAIL,
+             "UBX %02X-%02X rejected", frame[2], frame[3]);
+    ERROR_IF(result != UBX_ACK_ACK,
+             return ESP_ERR_TIMEOUT,
+             "UBX %02X-%02X not answered", frame[2], frame[3]);
+    return ESP_OK;
+}
+
+// send each CFG-VALSET frame of a precompiled profile, see profiles/*.csv
+static esp_err_t ubx_send_profile(const uint8_t *profile, size_t len)
+{
+    esp_err_t err = ESP_OK;
+
+    while (err == ESP_OK && len >= UBX_HEADER_LEN + UBX_CHECKSUM_LEN)
+    {
+        size_t n = UBX_HEADER_LEN + (profile[4] | (profile[5] << 8)) + UBX_CHECKSUM_LEN;
+        err = ubx_send_cmd(profile, n, UBX_ACK_TIMEOUT_MS, UBX_ACK_RETRIES);
+        profile += n;
+        len -= n;
+    }
+
+    return err;
+}
+
+esp_err_t ubx_set_default()
+{
+    esp_err_t err = ubx_send_profile(UBX_PROFILE_DEFAULT, UBX_PROFILE_DEFAULT_LEN);
+    ERROR_IF(err != ESP_OK,
+             return err,
+             "Cannot set receiver defaults");
+
+    /*
+     * MODE
+     */
+    // default in rover mode
+    return ubx_set_mode_rover();
+}
+
+esp_err_t ubx_set_mode_rover()
+{
+    esp_err_t err = ubx_send_profile(UBX_PROFILE_ROVER, UBX_PROFILE_ROVER_LEN);
+
+    status_set(STATUS_GNSS_MODE, err == ESP_OK ? "Rover" : "Rover failed");
+    return err;
+}
+
+esp_err_t ubx_set_mode_survey(const char *dur, const char *acc)
+{
+    esp_err_t err = ubx_send_profile(UBX_PROFILE_SURVEY, UBX_PROFILE_SURVEY_LEN);
+
+    status_set(STATUS_GNSS_MODE, err == ESP_OK ? "Base-Survey" : "Base-Survey failed");
+    return err;
+}
+
+// position in the unit of the HP keys, each standard key takes position / 100
+static esp_err_t ubx_set_mode_fixed_pos(uint8_t pos_type, const uint32_t *keys, const uint32_t *keys_hp, const int64_t *pos)
+{
+    uint8_t buffer[UBX_MSG_LEN];
+    uint8_t *q = ubx_valset_begin(buffer, UBX_LAYER_RAM);
+    esp_err_t err;
+
+    q = ubx_valset_add(q, UBX_KEY_TMODE_POS_TYPE, pos_type);
+    for (size_t i = 0; i < 3; i++)
+    {
+        q = ubx_valset_add_hp(q, keys[i], keys_hp[i], pos[i]);
+    }
 
     // ACC = 500 x 0.1 = 50mm = 5 cm
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-TMODE-FIXED_POS_ACC 500", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
+    q = ubx_valset_add(q, UBX_KEY_TMODE_FIXED_POS_ACC, 500);
 
     // TMODE Enabled in Fixed mode
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-TMODE-MODE 2", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
+    q = ubx_valset_add(q, UBX_KEY_TMODE_MODE, UBX_TMODE_MODE_FIXED);
 
     // Enable RTCM3 output on UART2
-    n = ubx_gen_cmd("CFG-VALSET 0 1 0 0 CFG-UART2OUTPROT-RTCM3X 1", buffer);
-    uart_write_bytes(UART_STATUS_PORT, buffer, n);
+    q = ubx_valset_add(q, UBX_KEY_UART2OUTPROT_RTCM3X, 1);
 
-    free(buffer);
+    err = ubx_send_cmd(buffer, ubx_valset_end(buffer, q), UBX_ACK_TIMEOUT_MS, UBX_ACK_RETRIES);
+
+    status_set(STATUS_GNSS_MODE, err == ESP_OK ? "Base-Fixed" : "Base-Fixed failed");
+    return err;
+}
+
+// lat, lon in 1e-9 deg, height in 0.1 mm
+esp_err_t ubx_set_mode_fixed_llh(int64_t lat, int64_t lon, int64_t height)
+{
+    static const uint32_t keys[] = {UBX_KEY_TMODE_LAT, UBX_KEY_TMODE_LON, UBX_KEY_TMODE_HEIGHT};
+    static const uint32_t keys_hp[] = {UBX_KEY_TMODE_LAT_HP, UBX_KEY_TMODE_LON_HP, UBX_KEY_TMODE_HEIGHT_HP};
+    const int64_t pos[] = {lat, lon, height};
+
+    ERROR_IF(llabs(lat) > 90000000000LL || llabs(lon) > 180000000000LL || llabs(height) > UBX_TMODE_POS_MAX,
+             status_set(STATUS_GNSS_MODE, "Base-Fixed failed");
+             return ESP_ERR_INVALID_ARG,
+             "Invalid base position");
+
+    return ubx_set_mode_fixed_pos(UBX_TMODE_POS_TYPE_LLH, keys, keys_hp, pos);
+}
+
+// x, y, z in 0.1 mm
+esp_err_t ubx_set_mode_fixed_ecef(int64_t x, int64_t y, int64_t z)
+{
+    static const uint32_t keys[] = {UBX_KEY_TMODE_ECEF_X, UBX_KEY_TMODE_ECEF_Y, UBX_KEY_TMODE_ECEF_Z};
+    static const uint32_t keys_hp[] = {UBX_KEY_TMODE_ECEF_X_HP, UBX_KEY_TMODE_ECEF_Y_HP, UBX_KEY_TMODE_ECEF_Z_HP};
+    const int64_t pos[] = {x, y, z};
 
-    vTaskDelay(pdMS_TO_TICKS(1000));
+    ERROR_IF(llabs(x) > UBX_TMODE_POS_MAX || llabs(y) > UBX_TMODE_POS_MAX || llabs(z) > UBX_TMODE_POS_MAX,
+             status_set(STATUS_GNSS_MODE, "Base-Fixed failed");
+             return ESP_ERR_INVALID_ARG,
+             "Invalid base position");
 
-    status_set(STATUS_GNSS_MODE, "Base-Fixed");
+    return ubx_set_mode_fixed_pos(UBX_TMODE_POS_TYPE_ECEF, keys, keys_hp, pos);
+}
+
+// lat, lon in degrees, alt in meters, as decimal strings
+esp_err_t ubx_set_mode_fixed(const char *lat, const char *lon, const char *alt)
+{
+    int64_t pos[3];
+
+    ERROR_IF(!ubx_parse_fixed(lat, 9, &pos[0]) || !ubx_parse_fixed(lon, 9, &pos[1]) || !ubx_parse_fixed(alt, 4, &pos[2]),
+             status_set(STATUS_GNSS_MODE, "Base-Fixed failed");
+             return ESP_ERR_INVALID_ARG,
+             "Invalid base position %s %s %s", lat, lon, alt);
+
+    return ubx_set_mode_fixed_llh(pos[0], pos[1], pos[2]);
+}
+
+// x, y, z in meters, as decimal strings
+esp_err_t ubx_set_mode_fixed_xyz(const char *x, const char *y, const char *z)
+{
+    int64_t pos[3];
+
+    ERROR_IF(!ubx_parse_fixed(x, 4, &pos[0]) || !ubx_parse_fixed(y, 4, &pos[1]) || !ubx_parse_fixed(z, 4, &pos[2]),
+             status_set(STATUS_GNSS_MODE, "Base-Fixed failed");
+             return ESP_ERR_INVALID_ARG,
+             "Invalid base position %s %s %s", x, y, z);
+
+    return ubx_set_mode_fixed_ecef(pos[0], pos[1], pos[2]);
 }
 
 void ubx_write_rtcm3(const char *buffer, size_t len)
@@ -307,70 +591,149 @@ void ubx_write_rtcm3(const char *buffer, size_t len)
     uart_write_bytes(UART_RTCM3_PORT, buffer, len);
 }
 
+static void uart_status_sentence_handler(const char *sentence, size_t len, void *ctx)
+{
+    //  if a GGA or GST message
+    if (len > 5)
+    {
+        if (sentence[3] == 'G' && sentence[4] == 'G' && sentence[5] == 'A')
+        {
+            status_set(STATUS_GNSS_GGA, sentence);
+            esp_event_post(UART_STATUS_EVENT_READ, len /* use len as event ID */, sentence, len, portMAX_DELAY);
+        }
+        else if (sentence[3] == 'G' && sentence[4] == 'S' && sentence[5] == 'T')
+        {
+            status_set(STATUS_GNSS_GST, sentence);
+        }
+    }
+}
+
+static void uart_status_frame_handler(uint8_t cls, uint8_t id, const uint8_t *payload, size_t len, void *ctx)
+{
+    char *buffer = ctx;
+
+    // payload of UBX-ACK-ACK and UBX-ACK-NAK is the class and id of the command
+    if (cls == UBX_CLASS_ACK && len == 2)
+    {
+        ubx_ack_received(payload[0], payload[1], id == UBX_ID_ACK_ACK ? UBX_ACK_ACK : UBX_ACK_NAK);
+        return;
+    }
+
+    if (cls != UBX_CLASS_NAV)
+    {
+        return;
+    }
+
+    // decode into a local copy, so that readers never see a half-written message
+    if (id == UBX_ID_NAV_PVT)
+    {
+        ubx_nav_pvt_t pvt;
+        if (ubx_decode_nav_pvt(payload, len, &pvt))
+        {
+            portENTER_CRITICAL(&uart_nav_lock);
+            uart_nav_pvt = pvt;
+            portEXIT_CRITICAL(&uart_nav_lock);
+
+            // fix type, satellites, horizontal and vertical accuracy in mm
+            sprintf(buffer, "%u %u %" PRIu32 " %" PRIu32, pvt.fixType, pvt.numSV, pvt.hAcc, pvt.vAcc);
+            status_set(STATUS_GNSS_PVT, buffer);
+        }
+    }
+    else if (id == UBX_ID_NAV_HPPOSLLH)
+    {
+        ubx_nav_hpposllh_t pos;
+        if (ubx_decode_nav_hpposllh(payload, len, &pos))
+        {
+            portENTER_CRITICAL(&uart_nav_lock);
+            uart_nav_hpposllh = pos;
+            portEXIT_CRITICAL(&uart_nav_lock);
+        }
+    }
+    else if (id == UBX_ID_NAV_SVIN)
+    {
+        ubx_nav_svin_t svin;
+        if (ubx_decode_nav_svin(payload, len, &svin))
+        {
+            portENTER_CRITICAL(&uart_nav_lock);
+            uart_nav_svin = svin;
+            portEXIT_CRITICAL(&uart_nav_lock);
+
+            // duration in s, observations, mean accuracy in 0.1 mm, valid, active
+            sprintf(buffer, "%" PRIu32 " %" PRIu32 " %" PRIu32 " %u %u", svin.dur, svin.obs, svin.meanAcc, svin.valid, svin.active);
+            status_set(STATUS_GNSS_SVIN, buffer);
+        }
+    }
+}
+
 static void uart_status_task(void *ctx)
 {
-    char *buffer = calloc(UART_STATUS_BUFFER_LEN, sizeof(char));
+    uint8_t *buffer = calloc(UART_STATUS_BUFFER_LEN, sizeof(uint8_t));
+    char *text = calloc(STATUS_LEN_MAX, sizeof(char));
+    nmea_parser_t *parser = calloc(1, sizeof(nmea_parser_t));
+    ubx_parser_t *ubx_parser = calloc(1, sizeof(ubx_parser_t));
+    uart_event_t event;
     int32_t len;
-    char *ptr;
 
     ESP_LOGI(TAG, "Start uart_status_task");
+    nmea_parser_init(parser);
+    ubx_parser_init(ubx_parser);
     uart_flush_input(UART_STATUS_PORT);
+    xQueueReset(uart_status_queue);
     while (true)
     {
-        // read a line
-        ptr = buffer;
-        while (1)
+        // the driver reports data on RX timeout (end of a burst) or when the FIFO fills up
+        if (xQueueReceive(uart_status_queue, &event, portMAX_DELAY) != pdTRUE)
         {
-            if (uart_read_bytes(UART_STATUS_PORT, ptr, 1, portMAX_DELAY) == 1)
-            {
-                if (*ptr == '\n')
-                {
-                    *ptr = 0;
-                    break;
-                }
-                ptr++;
-            }
+            continue;
         }
 
-        // replace '\r' by '\0'
-        len = ptr - buffer - 1;
-        buffer[len] = '\0';
-
-        //  if a GGA or GST message
-        if (len > 5 && buffer[0] == '$')
+        switch (event.type)
         {
-            if (buffer[3] == 'G' && buffer[4] == 'G' && buffer[5] == 'A')
-            {
-                status_set(STATUS_GNSS_GGA, buffer);
-                esp_event_post(UART_STATUS_EVENT_READ, len /* use len as event ID */, buffer, len, portMAX_DELAY);
-            }
-            else if (buffer[3] == 'G' && buffer[4] == 'S' && buffer[5] == 'T')
+        case UART_DATA:
+            // read everything which is buffered, then split it into NMEA sentences and UBX frames,
+            // each parser skips the bytes of the other protocol
+            len = uart_read_bytes(UART_STATUS_PORT, buffer, MIN(event.size, UART_STATUS_BUFFER_LEN), 0);
+            if (len > 0)
             {
-                status_set(STATUS_GNSS_GST, buffer);
+                nmea_parser_feed(parser, buffer, len, uart_status_sentence_handler, NULL);
+                ubx_parser_feed(ubx_parser, buffer, len, uart_status_frame_handler, text);
             }
+            break;
+        case UART_FIFO_OVF:
+        case UART_BUFFER_FULL:
+            ESP_LOGW(TAG, "UART_STATUS overflow");
+            uart_flush_input(UART_STATUS_PORT);
+            xQueueReset(uart_status_queue);
+            nmea_parser_init(parser);
+            ubx_parser_init(ubx_parser);
+            break;
+        default:
+            break;
         }
-
-        vTaskDelay(pdMS_TO_TICKS(50));
     }
 }
 
+static void uart_rtcm3_frame_handler(const uint8_t *frame, size_t len, void *ctx)
+{
+    fanout_write(rtcm3_fanout, frame, len);
+}
+
 static void uart_rtcm3_task(void *ctx)
 {
-    char *buffer = calloc(UART_STATUS_BUFFER_LEN, sizeof(char));
+    uint8_t *buffer = calloc(RTCM3_FRAME_LEN_MAX, sizeof(uint8_t));
+    rtcm3_parser_t *parser = calloc(1, sizeof(rtcm3_parser_t));
     int32_t len;
 
     ESP_LOGI(TAG, "Start uart_rtcm3_task");
+    rtcm3_parser_init(parser);
     uart_flush_input(UART_RTCM3_PORT);
     while (true)
     {
-        len = uart_read_bytes(UART_RTCM3_PORT, buffer, UART_STATUS_BUFFER_LEN, pdMS_TO_TICKS(500));
+        // only ask for the rest of the current frame, so that it is forwarded as soon as its last byte arrives
+        len = uart_read_bytes(UART_RTCM3_PORT, buffer, rtcm3_parser_wanted(parser), portMAX_DELAY);
         if (len > 0)
         {
-            esp_event_post(UART_RTCM3_EVENT_READ, len /* use len as event ID */, buffer, len, portMAX_DELAY);
-        }
-        else // keep sockets alive
-        {
-            esp_event_post(UART_RTCM3_EVENT_READ, 4, "GNSS", 4, portMAX_DELAY);
+            rtcm3_parser_feed(parser, buffer, len, uart_rtcm3_frame_handler, NULL);
         }
     }
 }
@@ -379,6 +742,11 @@ esp_err_t uart_init()
 {
     esp_err_t err = ESP_OK;
 
+    rtcm3_fanout = fanout_create(UART_RTCM3_FANOUT_LEN);
+    ERROR_IF(rtcm3_fanout == NULL,
+             return ESP_ERR_NO_MEM,
+             "Cannot allocate RTCM3 buffer");
+
     /*
      * start UART_STATUS port
      */
@@ -389,17 +757,12 @@ esp_err_t uart_init()
     err = uart_set_pin(UART_STATUS_PORT,
                        UART_STATUS_PIN_TX, UART_STATUS_PIN_RX,
                        UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
-    // start driver, RX buffer = UART_STATUS_BUFFER_LEN, no TX  buffer, no UART queue, no UART event
-    err = uart_driver_install(UART_STATUS_PORT, UART_STATUS_BUFFER_LEN, 0, 0, NULL, 0);
+    // start driver, RX buffer = UART_STATUS_BUFFER_LEN, no TX  buffer, UART event queue for RX data
+    err = uart_driver_install(UART_STATUS_PORT, UART_STATUS_BUFFER_LEN, 0, UART_STATUS_QUEUE_LEN, &uart_status_queue, 0);
     ERROR_IF(err != ESP_OK,
              return ESP_FAIL,
              "Cannot start UART_STATUS");
 
-    vTaskDelay(pdMS_TO_TICKS(1000));
-
-    // initialize Ublox
-    ubx_set_default();
-
     /*
      * start UART_RTCM3 port
      */
@@ -416,12 +779,42 @@ esp_err_t uart_init()
              return ESP_FAIL,
              "Cannot start UART_RTCM3");
 
-    vTaskDelay(pdMS_TO_TICKS(1000));
+    /*
+     * negotiate baudrates, UART_STATUS first as it carries the commands for both
+     */
+    bool status_ok = uart_negotiate(UART_STATUS_PORT, "CFG-UART1-BAUDRATE", CONFIG_UART_STATUS_BAUD) > 0;
+    bool rtcm3_ok = false;
+
+    // UBX output on UART2 is only needed to answer the probes
+    if (status_ok && uart_probe_valset("CFG-VALSET 0 1 0 0 CFG-UART2OUTPROT-UBX 1"))
+    {
+        rtcm3_ok = uart_negotiate(UART_RTCM3_PORT, "CFG-UART2-BAUDRATE", CONFIG_UART_RTCM3_BAUD) > 0;
+    }
 
     /*
-     * start reading tasks
+     * start reading tasks, uart_status_task also completes the commands below
      */
+    for (size_t i = 0; i < UBX_PENDING_MAX; i++)
+    {
+        ubx_pending[i].done = xSemaphoreCreateBinary();
+    }
     xTaskCreate(uart_status_task, "uart_status", 2 * UART_STATUS_BUFFER_LEN, NULL, 10, NULL);
     xTaskCreate(uart_rtcm3_task, "uart_rtcm3", 2 * UART_RTCM3_BUFFER_LEN, NULL, 10, NULL);
-    return err;
+
+    // the profile goes through UART_STATUS, there is no point in pushing it without an answer there
+    ERROR_IF(!status_ok,
+             return ESP_ERR_NOT_FOUND,
+             "No receiver on UART_STATUS, default config not sent");
+
+    // initialize Ublox
+    err = ubx_set_default();
+    ERROR_IF(err != ESP_OK,
+             return err,
+             "Receiver does not accept the default config");
+
+    ERROR_IF(!rtcm3_ok,
+             return ESP_ERR_NOT_FOUND,
+             "No receiver on UART_RTCM3, RTCM3 output may not arrive");
+
+    return ESP_OK;
 }
@@ -16,6 +16,7 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <inttypes.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
@@ -42,6 +43,9 @@ static const char *TAG = "UBLOX";
 #define FR8 9
 #define FS32 10
 
+#define UBX_FIELDS_MAX 32 /* fields of a fixed payload, width of the prm rows */
+#define UBX_ARGS_MAX (5 + 2 * UBX_VALSET_KEYS_MAX) /* command, VALSET header, key value pairs */
+
 #define ROUND(x) (int)floor((x) + 0.5)
 
 /* get fields (little-endian) ------------------------------------------------*/
@@ -55,6 +59,13 @@ static uint16_t U2(uint8_t *p)
     return u;
 }
 
+static int16_t I2(uint8_t *p)
+{
+    int16_t i;
+    memcpy(&i, p, 2);
+    return i;
+}
+
 static uint32_t U4(uint8_t *p)
 {
     uint32_t u;
@@ -104,6 +115,11 @@ static void setU4(uint8_t *p, uint32_t u)
     memcpy(p, &u, 4);
 }
 
+static void setU8(uint8_t *p, uint64_t u)
+{
+    memcpy(p, &u, 8);
+}
+
 static void
 setI1(uint8_t *p, int8_t i)
 {
@@ -162,13 +178,745 @@ static void set_checksum(uint8_t *buff, int len)
 static int stoi(const char *s)
 {
     uint32_t n;
-    if (sscanf(s, "0x%lX", &n) == 1)
+    if (sscanf(s, "0x%" SCNx32, &n) == 1)
     {
         return (int)n; /* hex (0xXXXX) */
     }
     return atoi(s);
 }
 
+/* convert string to 64-bit integer, decimal or hex (0xXXXX) ----------------*/
+static int64_t stoi64(const char *s)
+{
+    if (!strncmp(s, "0x", 2) || !strncmp(s, "0X", 2))
+    {
+        return (int64_t)strtoull(s, NULL, 16);
+    }
+    return strtoll(s, NULL, 10);
+}
+
+/* VALSET keys courtesy of gpsd's ubxtool ------------------------------------
+ * sorted by name for binary search, names are without the "CFG-" prefix
+ *-----------------------------------------------------------------------------*/
+typedef struct ubx_valset_key_t
+{
+    const char *name;
+    uint32_t id;
+    int type;
+} ubx_valset_key_t;
+
+static const ubx_valset_key_t VALSET_KEYS[] = {
+    {"GEOFENCE-CONFLVL",                0x20240011, FU1},
+    {"GEOFENCE-FENCE1_LAT",             0x40240021, FI4},
+    {"GEOFENCE-FENCE1_LON",             0x40240022, FI4},
+    {"GEOFENCE-FENCE1_RAD",             0x40240023, FU4},
+    {"GEOFENCE-FENCE2_LAT",             0x40240031, FI4},
+    {"GEOFENCE-FENCE2_LON",             0x40240032, FI4},
+    {"GEOFENCE-FENCE2_RAD",             0x40240033, FU4},
+    {"GEOFENCE-FENCE3_LAT",             0x40240041, FI4},
+    {"GEOFENCE-FENCE3_LON",             0x40240042, FI4},
+    {"GEOFENCE-FENCE3_RAD",             0x40240043, FU4},
+    {"GEOFENCE-FENCE4_LAT",             0x40240051, FI4},
+    {"GEOFENCE-FENCE4_LON",             0x40240052, FI4},
+    {"GEOFENCE-FENCE4_RAD",             0x40240053, FU4},
+    {"GEOFENCE-PIN",                    0x20240014, FU1},
+    {"GEOFENCE-PINPOL",                 0x20240013, FU1},
+    {"GEOFENCE-USE_FENCE1",             0x10240020, FU1},
+    {"GEOFENCE-USE_FENCE2",             0x10240030, FU1},
+    {"GEOFENCE-USE_FENCE3",             0x10240040, FU1},
+    {"GEOFENCE-USE_FENCE4",             0x10240050, FU1},
+    {"GEOFENCE-USE_PIO",                0x10240012, FU1},
+    {"HW-ANT_CFG_OPENDET",              0x10a30031, FU1},
+    {"HW-ANT_CFG_OPENDET_POL",          0x10a30032, FU1},
+    {"HW-ANT_CFG_PWRDOWN",              0x10a30033, FU1},
+    {"HW-ANT_CFG_PWRDOWN_POL",          0x10a30034, FU1},
+    {"HW-ANT_CFG_RECOVER",              0x10a30035, FU1},
+    {"HW-ANT_CFG_SHORTDET",             0x10a3002f, FU1},
+    {"HW-ANT_CFG_SHORTDET_POL",         0x10a30030, FU1},
+    {"HW-ANT_CFG_VOLTCTRL",             0x10a3002e, FU1},
+    {"HW-ANT_SUP_OPEN_PIN",             0x20a30038, FU1},
+    {"HW-ANT_SUP_SHORT_PIN",            0x20a30037, FU1},
+    {"HW-ANT_SUP_SWITCH_PIN",           0x20a30036, FU1},
+    {"I2C-ADDRESS",                     0x20510001, FU1},
+    {"I2C-ENABLED",                     0x10510003, FU1},
+    {"I2C-EXTENDEDTIMEOUT",             0x10510002, FU1},
+    {"I2CINPROT-NMEA",                  0x10710002, FU1},
+    {"I2CINPROT-RTCM2X",                0x10710003, FU1},
+    {"I2CINPROT-RTCM3X",                0x10710004, FU1},
+    {"I2CINPROT-UBX",                   0x10710001, FU1},
+    {"I2COUTPROT-NMEA",                 0x10720002, FU1},
+    {"I2COUTPROT-RTCM3X",               0x10720004, FU1},
+    {"I2COUTPROT-UBX",                  0x10720001, FU1},
+    {"INFMSG-NMEA_I2C",                 0x20920006, FU1},
+    {"INFMSG-NMEA_SPI",                 0x2092000a, FU1},
+    {"INFMSG-NMEA_UART1",               0x20920007, FU1},
+    {"INFMSG-NMEA_UART2",               0x20920008, FU1},
+    {"INFMSG-NMEA_USB",                 0x20920009, FU1},
+    {"INFMSG-UBX_I2C",                  0x20920001, FU1},
+    {"INFMSG-UBX_SPI",                  0x20920005, FU1},
+    {"INFMSG-UBX_UART1",                0x20920002, FU1},
+    {"INFMSG-UBX_UART2",                0x20920003, FU1},
+    {"INFMSG-UBX_USB",                  0x20920004, FU1},
+    {"ITFM-ANTSETTING",                 0x20410010, FU1},
+    {"ITFM-BBTHRESHOLD",                0x20410001, FU1},
+    {"ITFM-CWTHRESHOLD",                0x20410002, FU1},
+    {"ITFM-ENABLE",                     0x1041000d, FU1},
+    {"ITFM-ENABLE_AUX",                 0x10410013, FU1},
+    {"LOGFILTER-APPLY_ALL_FILTERS",     0x10de0004, FU1},
+    {"LOGFILTER-MIN_INTERVAL",          0x30de0005, FU2},
+    {"LOGFILTER-ONCE_PER_WAKE_UP_ENA",  0x10de0003, FU1},
+    {"LOGFILTER-POSITION_THRS",         0x40de0008, FU4},
+    {"LOGFILTER-RECORD_ENA",            0x10de0002, FU1},
+    {"LOGFILTER-SPEED_THRS",            0x30de0007, FU2},
+    {"LOGFILTER-TIME_THRS",             0x30de0006, FU2},
+    {"MOT-GNSSDIST_THRS",               0x3025003b, FU2},
+    {"MOT-GNSSSPEED_THRS",              0x20250038, FU1},
+    {"MSGOUT-NMEA_ID_DTM_I2C",          0x209100a6, FU1},
+    {"MSGOUT-NMEA_ID_DTM_SPI",          0x209100aa, FU1},
+    {"MSGOUT-NMEA_ID_DTM_UART1",        0x209100a7, FU1},
+    {"MSGOUT-NMEA_ID_DTM_UART2",        0x209100a8, FU1},
+    {"MSGOUT-NMEA_ID_DTM_USB",          0x209100a9, FU1},
+    {"MSGOUT-NMEA_ID_GBS_I2C",          0x209100dd, FU1},
+    {"MSGOUT-NMEA_ID_GBS_SPI",          0x209100e1, FU1},
+    {"MSGOUT-NMEA_ID_GBS_UART1",        0x209100de, FU1},
+    {"MSGOUT-NMEA_ID_GBS_UART2",        0x209100df, FU1},
+    {"MSGOUT-NMEA_ID_GBS_USB",          0x209100e0, FU1},
+    {"MSGOUT-NMEA_ID_GGA_I2C",          0x209100ba, FU1},
+    {"MSGOUT-NMEA_ID_GGA_SPI",          0x209100be, FU1},
+    {"MSGOUT-NMEA_ID_GGA_UART1",        0x209100bb, FU1},
+    {"MSGOUT-NMEA_ID_GGA_UART2",        0x209100bc, FU1},
+    {"MSGOUT-NMEA_ID_GGA_USB",          0x209100bd, FU1},
+    {"MSGOUT-NMEA_ID_GLL_I2C",          0x209100c9, FU1},
+    {"MSGOUT-NMEA_ID_GLL_SPI",          0x209100cd, FU1},
+    {"MSGOUT-NMEA_ID_GLL_UART1",        0x209100ca, FU1},
+    {"MSGOUT-NMEA_ID_GLL_UART2",        0x209100cb, FU1},
+    {"MSGOUT-NMEA_ID_GLL_USB",          0x209100cc, FU1},
+    {"MSGOUT-NMEA_ID_GNS_I2C",          0x209100b5, FU1},
+    {"MSGOUT-NMEA_ID_GNS_SPI",          0x209100b9, FU1},
+    {"MSGOUT-NMEA_ID_GNS_UART1",        0x209100b6, FU1},
+    {"MSGOUT-NMEA_ID_GNS_UART2",        0x209100b7, FU1},
+    {"MSGOUT-NMEA_ID_GNS_USB",          0x209100b8, FU1},
+    {"MSGOUT-NMEA_ID_GRS_I2C",          0x209100ce, FU1},
+    {"MSGOUT-NMEA_ID_GRS_SPI",          0x209100d2, FU1},
+    {"MSGOUT-NMEA_ID_GRS_UART1",        0x209100cf, FU1},
+    {"MSGOUT-NMEA_ID_GRS_UART2",        0x209100d0, FU1},
+    {"MSGOUT-NMEA_ID_GRS_USB",          0x209100d1, FU1},
+    {"MSGOUT-NMEA_ID_GSA_I2C",          0x209100bf, FU1},
+    {"MSGOUT-NMEA_ID_GSA_SPI",          0x209100c3, FU1},
+    {"MSGOUT-NMEA_ID_GSA_UART1",        0x209100c0, FU1},
+    {"MSGOUT-NMEA_ID_GSA_UART2",        0x209100c1, FU1},
+    {"MSGOUT-NMEA_ID_GSA_USB",          0x209100c2, FU1},
+    {"MSGOUT-NMEA_ID_GST_I2C",          0x209100d3, FU1},
+    {"MSGOUT-NMEA_ID_GST_SPI",          0x209100d7, FU1},
+    {"MSGOUT-NMEA_ID_GST_UART1",        0x209100d4, FU1},
+    {"MSGOUT-NMEA_ID_GST_UART2",        0x209100d5, FU1},
+    {"MSGOUT-NMEA_ID_GST_USB",          0x209100d6, FU1},
+    {"MSGOUT-NMEA_ID_GSV_I2C",          0x209100c4, FU1},
+    {"MSGOUT-NMEA_ID_GSV_SPI",          0x209100c8, FU1},
+    {"MSGOUT-NMEA_ID_GSV_UART1",        0x209100c5, FU1},
+    {"MSGOUT-NMEA_ID_GSV_UART2",        0x209100c6, FU1},
+    {"MSGOUT-NMEA_ID_GSV_USB",          0x209100c7, FU1},
+    {"MSGOUT-NMEA_ID_RMC_I2C",          0x209100ab, FU1},
+    {"MSGOUT-NMEA_ID_RMC_SPI",          0x209100af, FU1},
+    {"MSGOUT-NMEA_ID_RMC_UART1",        0x209100ac, FU1},
+    {"MSGOUT-NMEA_ID_RMC_UART2",        0x209100ad, FU1},
+    {"MSGOUT-NMEA_ID_RMC_USB",          0x209100ae, FU1},
+    {"MSGOUT-NMEA_ID_VLW_I2C",          0x209100e7, FU1},
+    {"MSGOUT-NMEA_ID_VLW_SPI",          0x209100eb, FU1},
+    {"MSGOUT-NMEA_ID_VLW_UART1",        0x209100e8, FU1},
+    {"MSGOUT-NMEA_ID_VLW_UART2",        0x209100e9, FU1},
+    {"MSGOUT-NMEA_ID_VLW_USB",          0x209100ea, FU1},
+    {"MSGOUT-NMEA_ID_VTG_I2C",          0x209100b0, FU1},
+    {"MSGOUT-NMEA_ID_VTG_SPI",          0x209100b4, FU1},
+    {"MSGOUT-NMEA_ID_VTG_UART1",        0x209100b1, FU1},
+    {"MSGOUT-NMEA_ID_VTG_UART2",        0x209100b2, FU1},
+    {"MSGOUT-NMEA_ID_VTG_USB",          0x209100b3, FU1},
+    {"MSGOUT-NMEA_ID_ZDA_I2C",          0x209100d8, FU1},
+    {"MSGOUT-NMEA_ID_ZDA_SPI",          0x209100dc, FU1},
+    {"MSGOUT-NMEA_ID_ZDA_UART1",        0x209100d9, FU1},
+    {"MSGOUT-NMEA_ID_ZDA_UART2",        0x209100da, FU1},
+    {"MSGOUT-NMEA_ID_ZDA_USB",          0x209100db, FU1},
+    {"MSGOUT-PUBX_ID_POLYP_I2C",        0x209100ec, FU1},
+    {"MSGOUT-PUBX_ID_POLYP_SPI",        0x209100f0, FU1},
+    {"MSGOUT-PUBX_ID_POLYP_UART1",      0x209100ed, FU1},
+    {"MSGOUT-PUBX_ID_POLYP_UART2",      0x209100ee, FU1},
+    {"MSGOUT-PUBX_ID_POLYP_USB",        0x209100ef, FU1},
+    {"MSGOUT-PUBX_ID_POLYS_I2C",        0x209100f1, FU1},
+    {"MSGOUT-PUBX_ID_POLYS_SPI",        0x209100f5, FU1},
+    {"MSGOUT-PUBX_ID_POLYS_UART1",      0x209100f2, FU1},
+    {"MSGOUT-PUBX_ID_POLYS_UART2",      0x209100f3, FU1},
+    {"MSGOUT-PUBX_ID_POLYS_USB",        0x209100f4, FU1},
+    {"MSGOUT-PUBX_ID_POLYT_I2C",        0x209100f6, FU1},
+    {"MSGOUT-PUBX_ID_POLYT_SPI",        0x209100fa, FU1},
+    {"MSGOUT-PUBX_ID_POLYT_UART1",      0x209100f7, FU1},
+    {"MSGOUT-PUBX_ID_POLYT_UART2",      0x209100f8, FU1},
+    {"MSGOUT-PUBX_ID_POLYT_USB",        0x209100f9, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1005_I2C",     0x209102bd, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1005_SPI",     0x209102c1, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1005_UART1",   0x209102be, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1005_UART2",   0x209102bf, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1005_USB",     0x209102c0, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1074_I2C",     0x2091035e, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1074_SPI",     0x20910362, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1074_UART1",   0x2091035f, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1074_UART2",   0x20910360, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1074_USB",     0x20910361, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1077_I2C",     0x209102cc, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1077_SPI",     0x209102d0, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1077_UART1",   0x209102cd, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1077_UART2",   0x209102ce, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1077_USB",     0x209102cf, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1084_SPI",     0x20910367, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1084_UART1",   0x20910364, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1084_UART2",   0x20910365, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1084_USB",     0x20910366, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1087_I2C",     0x209102d1, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1087_SPI",     0x209102d5, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1087_UART1",   0x209102d2, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1087_UART2",   0x209102d3, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1087_USB",     0x209102d4, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1094_I2C",     0x20910368, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1094_SPI",     0x2091036c, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1094_UART1",   0x20910369, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1094_UART2",   0x2091036a, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1094_USB",     0x2091036b, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1097_I2C",     0x20910318, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1097_SPI",     0x2091031c, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1097_UART1",   0x20910319, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1097_UART2",   0x2091031a, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1097_USB",     0x2091031b, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1124_I2C",     0x2091036d, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1124_SPI",     0x20910371, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1124_UART1",   0x2091036e, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1124_UART2",   0x2091036f, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1124_USB",     0x20910370, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1127_I2C",     0x209102d6, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1127_SPI",     0x209102da, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1127_UART1",   0x209102d7, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1127_UART2",   0x209102d8, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1127_USB",     0x209102d9, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1230_I2C",     0x20910303, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1230_SPI",     0x20910307, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1230_UART1",   0x20910304, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1230_UART2",   0x20910305, FU1},
+    {"MSGOUT-RTCM_3X_TYPE1230_USB",     0x20910306, FU1},
+    {"MSGOUT-RTCM_3X_TYPE4072_0_I2C",   0x209102fe, FU1},
+    {"MSGOUT-RTCM_3X_TYPE4072_0_SPI",   0x20910302, FU1},
+    {"MSGOUT-RTCM_3X_TYPE4072_0_UART1", 0x209102ff, FU1},
+    {"MSGOUT-RTCM_3X_TYPE4072_0_UART2", 0x20910300, FU1},
+    {"MSGOUT-RTCM_3X_TYPE4072_0_USB",   0x20910301, FU1},
+    {"MSGOUT-RTCM_3X_TYPE4072_1_I2C",   0x20910381, FU1},
+    {"MSGOUT-RTCM_3X_TYPE4072_1_SPI",   0x20910385, FU1},
+    {"MSGOUT-RTCM_3X_TYPE4072_1_UART1", 0x20910382, FU1},
+    {"MSGOUT-RTCM_3X_TYPE4072_1_UART2", 0x20910383, FU1},
+    {"MSGOUT-RTCM_3X_TYPE4072_1_USB",   0x20910384, FU1},
+    {"MSGOUT-UBX_LOG_INFO_I2C",         0x20910259, FU1},
+    {"MSGOUT-UBX_LOG_INFO_SPI",         0x2091025d, FU1},
+    {"MSGOUT-UBX_LOG_INFO_UART1",       0x2091025a, FU1},
+    {"MSGOUT-UBX_LOG_INFO_UART2",       0x2091025b, FU1},
+    {"MSGOUT-UBX_LOG_INFO_USB",         0x2091025c, FU1},
+    {"MSGOUT-UBX_MON_COMMS_I2C",        0x2091034f, FU1},
+    {"MSGOUT-UBX_MON_COMMS_SPI",        0x20910353, FU1},
+    {"MSGOUT-UBX_MON_COMMS_UART1",      0x20910350, FU1},
+    {"MSGOUT-UBX_MON_COMMS_UART2",      0x20910351, FU1},
+    {"MSGOUT-UBX_MON_COMMS_USB",        0x20910352, FU1},
+    {"MSGOUT-UBX_MON_HW2_I2C",          0x209101b9, FU1},
+    {"MSGOUT-UBX_MON_HW2_SPI",          0x209101bd, FU1},
+    {"MSGOUT-UBX_MON_HW2_UART1",        0x209101ba, FU1},
+    {"MSGOUT-UBX_MON_HW2_UART2",        0x209101bb, FU1},
+    {"MSGOUT-UBX_MON_HW2_USB",          0x209101bc, FU1},
+    {"MSGOUT-UBX_MON_HW3_I2C",          0x20910354, FU1},
+    {"MSGOUT-UBX_MON_HW3_SPI",          0x20910358, FU1},
+    {"MSGOUT-UBX_MON_HW3_UART1",        0x20910355, FU1},
+    {"MSGOUT-UBX_MON_HW3_UART2",        0x20910356, FU1},
+    {"MSGOUT-UBX_MON_HW3_USB",          0x20910357, FU1},
+    {"MSGOUT-UBX_MON_HW_I2C",           0x209101b4, FU1},
+    {"MSGOUT-UBX_MON_HW_SPI",           0x209101b8, FU1},
+    {"MSGOUT-UBX_MON_HW_UART1",         0x209101b5, FU1},
+    {"MSGOUT-UBX_MON_HW_UART2",         0x209101b6, FU1},
+    {"MSGOUT-UBX_MON_HW_USB",           0x209101b7, FU1},
+    {"MSGOUT-UBX_MON_IO_I2C",           0x209101a5, FU1},
+    {"MSGOUT-UBX_MON_IO_SPI",           0x209101a9, FU1},
+    {"MSGOUT-UBX_MON_IO_UART1",         0x209101a6, FU1},
+    {"MSGOUT-UBX_MON_IO_UART2",         0x209101a7, FU1},
+    {"MSGOUT-UBX_MON_IO_USB",           0x209101a8, FU1},
+    {"MSGOUT-UBX_MON_MSGPP_I2C",        0x20910196, FU1},
+    {"MSGOUT-UBX_MON_MSGPP_SPI",        0x2091019a, FU1},
+    {"MSGOUT-UBX_MON_MSGPP_UART1",      0x20910197, FU1},
+    {"MSGOUT-UBX_MON_MSGPP_UART2",      0x20910198, FU1},
+    {"MSGOUT-UBX_MON_MSGPP_USB",        0x20910199, FU1},
+    {"MSGOUT-UBX_MON_RF_I2C",           0x20910359, FU1},
+    {"MSGOUT-UBX_MON_RF_SPI",           0x2091035d, FU1},
+    {"MSGOUT-UBX_MON_RF_UART1",         0x2091035a, FU1},
+    {"MSGOUT-UBX_MON_RF_UART2",         0x2091035b, FU1},
+    {"MSGOUT-UBX_MON_RF_USB",           0x2091035c, FU1},
+    {"MSGOUT-UBX_MON_RXBUF_I2C",        0x209101a0, FU1},
+    {"MSGOUT-UBX_MON_RXBUF_SPI",        0x209101a4, FU1},
+    {"MSGOUT-UBX_MON_RXBUF_UART1",      0x209101a1, FU1},
+    {"MSGOUT-UBX_MON_RXBUF_UART2",      0x209101a2, FU1},
+    {"MSGOUT-UBX_MON_RXBUF_USB",        0x209101a3, FU1},
+    {"MSGOUT-UBX_MON_RXR_I2C",          0x20910187, FU1},
+    {"MSGOUT-UBX_MON_RXR_SPI",          0x2091018b, FU1},
+    {"MSGOUT-UBX_MON_RXR_UART1",        0x20910188, FU1},
+    {"MSGOUT-UBX_MON_RXR_UART2",        0x20910189, FU1},
+    {"MSGOUT-UBX_MON_RXR_USB",          0x2091018a, FU1},
+    {"MSGOUT-UBX_MON_TXBUF_I2C",        0x2091019b, FU1},
+    {"MSGOUT-UBX_MON_TXBUF_SPI",        0x2091019f, FU1},
+    {"MSGOUT-UBX_MON_TXBUF_UART1",      0x2091019c, FU1},
+    {"MSGOUT-UBX_MON_TXBUF_UART2",      0x2091019d, FU1},
+    {"MSGOUT-UBX_MON_TXBUF_USB",        0x2091019e, FU1},
+    {"MSGOUT-UBX_NAV_CLOCK_I2C",        0x20910065, FU1},
+    {"MSGOUT-UBX_NAV_CLOCK_SPI",        0x20910069, FU1},
+    {"MSGOUT-UBX_NAV_CLOCK_UART1",      0x20910066, FU1},
+    {"MSGOUT-UBX_NAV_CLOCK_UART2",      0x20910067, FU1},
+    {"MSGOUT-UBX_NAV_CLOCK_USB",        0x20910068, FU1},
+    {"MSGOUT-UBX_NAV_DOP_I2C",          0x20910038, FU1},
+    {"MSGOUT-UBX_NAV_DOP_SPI",          0x2091003c, FU1},
+    {"MSGOUT-UBX_NAV_DOP_UART1",        0x20910039, FU1},
+    {"MSGOUT-UBX_NAV_DOP_UART2",        0x2091003a, FU1},
+    {"MSGOUT-UBX_NAV_DOP_USB",          0x2091003b, FU1},
+    {"MSGOUT-UBX_NAV_EOE_I2C",          0x2091015f, FU1},
+    {"MSGOUT-UBX_NAV_EOE_SPI",          0x20910163, FU1},
+    {"MSGOUT-UBX_NAV_EOE_UART1",        0x20910160, FU1},
+    {"MSGOUT-UBX_NAV_EOE_UART2",        0x20910161, FU1},
+    {"MSGOUT-UBX_NAV_EOE_USB",          0x20910162, FU1},
+    {"MSGOUT-UBX_NAV_GEOFENCE_I2C",     0x209100a1, FU1},
+    {"MSGOUT-UBX_NAV_GEOFENCE_SPI",     0x209100a5, FU1},
+    {"MSGOUT-UBX_NAV_GEOFENCE_UART1",   0x209100a2, FU1},
+    {"MSGOUT-UBX_NAV_GEOFENCE_UART2",   0x209100a3, FU1},
+    {"MSGOUT-UBX_NAV_GEOFENCE_USB",     0x209100a4, FU1},
+    {"MSGOUT-UBX_NAV_HPPOSECEF_I2C",    0x2091002e, FU1},
+    {"MSGOUT-UBX_NAV_HPPOSECEF_SPI",    0x20910032, FU1},
+    {"MSGOUT-UBX_NAV_HPPOSECEF_UART1",  0x2091002f, FU1},
+    {"MSGOUT-UBX_NAV_HPPOSECEF_UART2",  0x20910030, FU1},
+    {"MSGOUT-UBX_NAV_HPPOSECEF_USB",    0x20910031, FU1},
+    {"MSGOUT-UBX_NAV_HPPOSLLH_I2C",     0x20910033, FU1},
+    {"MSGOUT-UBX_NAV_HPPOSLLH_SPI",     0x20910037, FU1},
+    {"MSGOUT-UBX_NAV_HPPOSLLH_UART1",   0x20910034, FU1},
+    {"MSGOUT-UBX_NAV_HPPOSLLH_UART2",   0x20910035, FU1},
+    {"MSGOUT-UBX_NAV_HPPOSLLH_USB",     0x20910036, FU1},
+    {"MSGOUT-UBX_NAV_ODO_I2C",          0x2091007e, FU1},
+    {"MSGOUT-UBX_NAV_ODO_SPI",          0x20910082, FU1},
+    {"MSGOUT-UBX_NAV_ODO_UART1",        0x2091007f, FU1},
+    {"MSGOUT-UBX_NAV_ODO_UART2",        0x20910080, FU1},
+    {"MSGOUT-UBX_NAV_ODO_USB",          0x20910081, FU1},
+    {"MSGOUT-UBX_NAV_ORB_I2C",          0x20910010, FU1},
+    {"MSGOUT-UBX_NAV_ORB_SPI",          0x20910014, FU1},
+    {"MSGOUT-UBX_NAV_ORB_UART1",        0x20910011, FU1},
+    {"MSGOUT-UBX_NAV_ORB_UART2",        0x20910012, FU1},
+    {"MSGOUT-UBX_NAV_ORB_USB",          0x20910013, FU1},
+    {"MSGOUT-UBX_NAV_POSECEF_I2C",      0x20910024, FU1},
+    {"MSGOUT-UBX_NAV_POSECEF_SPI",      0x20910028, FU1},
+    {"MSGOUT-UBX_NAV_POSECEF_UART1",    0x20910025, FU1},
+    {"MSGOUT-UBX_NAV_POSECEF_UART2",    0x20910026, FU1},
+    {"MSGOUT-UBX_NAV_POSECEF_USB",      0x20910027, FU1},
+    {"MSGOUT-UBX_NAV_POSLLH_I2C",       0x20910029, FU1},
+    {"MSGOUT-UBX_NAV_POSLLH_SPI",       0x2091002d, FU1},
+    {"MSGOUT-UBX_NAV_POSLLH_UART1",     0x2091002a, FU1},
+    {"MSGOUT-UBX_NAV_POSLLH_UART2",     0x2091002b, FU1},
+    {"MSGOUT-UBX_NAV_POSLLH_USB",       0x2091002c, FU1},
+    {"MSGOUT-UBX_NAV_PVT_I2C",          0x20910006, FU1},
+    {"MSGOUT-UBX_NAV_PVT_SPI",          0x2091000a, FU1},
+    {"MSGOUT-UBX_NAV_PVT_UART1",        0x20910007, FU1},
+    {"MSGOUT-UBX_NAV_PVT_UART2",        0x20910008, FU1},
+    {"MSGOUT-UBX_NAV_PVT_USB",          0x20910009, FU1},
+    {"MSGOUT-UBX_NAV_RELPOSNED_I2C",    0x2091008d, FU1},
+    {"MSGOUT-UBX_NAV_RELPOSNED_SPI",    0x20910091, FU1},
+    {"MSGOUT-UBX_NAV_RELPOSNED_UART1",  0x2091008e, FU1},
+    {"MSGOUT-UBX_NAV_RELPOSNED_UART2",  0x2091008f, FU1},
+    {"MSGOUT-UBX_NAV_RELPOSNED_USB",    0x20910090, FU1},
+    {"MSGOUT-UBX_NAV_SAT_I2C",          0x20910015, FU1},
+    {"MSGOUT-UBX_NAV_SAT_SPI",          0x20910019, FU1},
+    {"MSGOUT-UBX_NAV_SAT_UART1",        0x20910016, FU1},
+    {"MSGOUT-UBX_NAV_SAT_UART2",        0x20910017, FU1},
+    {"MSGOUT-UBX_NAV_SAT_USB",          0x20910018, FU1},
+    {"MSGOUT-UBX_NAV_SBAS_I2C",         0x2091006a, FU1},
+    {"MSGOUT-UBX_NAV_SBAS_SPI",         0x2091006e, FU1},
+    {"MSGOUT-UBX_NAV_SBAS_UART1",       0x2091006b, FU1},
+    {"MSGOUT-UBX_NAV_SBAS_UART2",       0x2091006c, FU1},
+    {"MSGOUT-UBX_NAV_SBAS_USB",         0x2091006d, FU1},
+    {"MSGOUT-UBX_NAV_SIG_I2C",          0x20910345, FU1},
+    {"MSGOUT-UBX_NAV_SIG_SPI",          0x20910349, FU1},
+    {"MSGOUT-UBX_NAV_SIG_UART1",        0x20910346, FU1},
+    {"MSGOUT-UBX_NAV_SIG_UART2",        0x20910347, FU1},
+    {"MSGOUT-UBX_NAV_SIG_USB",          0x20910348, FU1},
+    {"MSGOUT-UBX_NAV_STATUS_I2C",       0x2091001a, FU1},
+    {"MSGOUT-UBX_NAV_STATUS_SPI",       0x2091001e, FU1},
+    {"MSGOUT-UBX_NAV_STATUS_UART1",     0x2091001b, FU1},
+    {"MSGOUT-UBX_NAV_STATUS_UART2",     0x2091001c, FU1},
+    {"MSGOUT-UBX_NAV_STATUS_USB",       0x2091001d, FU1},
+    {"MSGOUT-UBX_NAV_SVIN_I2C",         0x20910088, FU1},
+    {"MSGOUT-UBX_NAV_SVIN_SPI",         0x2091008c, FU1},
+    {"MSGOUT-UBX_NAV_SVIN_UART1",       0x20910089, FU1},
+    {"MSGOUT-UBX_NAV_SVIN_UART2",       0x2091008a, FU1},
+    {"MSGOUT-UBX_NAV_SVIN_USB",         0x2091008b, FU1},
+    {"MSGOUT-UBX_NAV_TIMEBDS_I2C",      0x20910051, FU1},
+    {"MSGOUT-UBX_NAV_TIMEBDS_SPI",      0x20910055, FU1},
+    {"MSGOUT-UBX_NAV_TIMEBDS_UART1",    0x20910052, FU1},
+    {"MSGOUT-UBX_NAV_TIMEBDS_UART2",    0x20910053, FU1},
+    {"MSGOUT-UBX_NAV_TIMEBDS_USB",      0x20910054, FU1},
+    {"MSGOUT-UBX_NAV_TIMEGAL_I2C",      0x20910056, FU1},
+    {"MSGOUT-UBX_NAV_TIMEGAL_SPI",      0x2091005a, FU1},
+    {"MSGOUT-UBX_NAV_TIMEGAL_UART1",    0x20910057, FU1},
+    {"MSGOUT-UBX_NAV_TIMEGAL_UART2",    0x20910058, FU1},
+    {"MSGOUT-UBX_NAV_TIMEGAL_USB",      0x20910059, FU1},
+    {"MSGOUT-UBX_NAV_TIMEGLO_I2C",      0x2091004c, FU1},
+    {"MSGOUT-UBX_NAV_TIMEGLO_SPI",      0x20910050, FU1},
+    {"MSGOUT-UBX_NAV_TIMEGLO_UART1",    0x2091004d, FU1},
+    {"MSGOUT-UBX_NAV_TIMEGLO_UART2",    0x2091004e, FU1},
+    {"MSGOUT-UBX_NAV_TIMEGLO_USB",      0x2091004f, FU1},
+    {"MSGOUT-UBX_NAV_TIMEGPS_I2C",      0x20910047, FU1},
+    {"MSGOUT-UBX_NAV_TIMEGPS_SPI",      0x2091004b, FU1},
+    {"MSGOUT-UBX_NAV_TIMEGPS_UART1",    0x20910048, FU1},
+    {"MSGOUT-UBX_NAV_TIMEGPS_UART2",    0x20910049, FU1},
+    {"MSGOUT-UBX_NAV_TIMEGPS_USB",      0x2091004a, FU1},
+    {"MSGOUT-UBX_NAV_TIMELS_I2C",       0x20910060, FU1},
+    {"MSGOUT-UBX_NAV_TIMELS_SPI",       0x20910064, FU1},
+    {"MSGOUT-UBX_NAV_TIMELS_UART1",     0x20910061, FU1},
+    {"MSGOUT-UBX_NAV_TIMELS_UART2",     0x20910062, FU1},
+    {"MSGOUT-UBX_NAV_TIMELS_USB",       0x20910063, FU1},
+    {"MSGOUT-UBX_NAV_TIMEUTC_I2C",      0x2091005b, FU1},
+    {"MSGOUT-UBX_NAV_TIMEUTC_SPI",      0x2091005f, FU1},
+    {"MSGOUT-UBX_NAV_TIMEUTC_UART1",    0x2091005c, FU1},
+    {"MSGOUT-UBX_NAV_TIMEUTC_UART2",    0x2091005d, FU1},
+    {"MSGOUT-UBX_NAV_TIMEUTC_USB",      0x2091005e, FU1},
+    {"MSGOUT-UBX_NAV_VELECEF_I2C",      0x2091003d, FU1},
+    {"MSGOUT-UBX_NAV_VELECEF_SPI",      0x20910041, FU1},
+    {"MSGOUT-UBX_NAV_VELECEF_UART1",    0x2091003e, FU1},
+    {"MSGOUT-UBX_NAV_VELECEF_UART2",    0x2091003f, FU1},
+    {"MSGOUT-UBX_NAV_VELECEF_USB",      0x20910040, FU1},
+    {"MSGOUT-UBX_NAV_VELNED_I2C",       0x20910042, FU1},
+    {"MSGOUT-UBX_NAV_VELNED_SPI",       0x20910046, FU1},
+    {"MSGOUT-UBX_NAV_VELNED_UART1",     0x20910043, FU1},
+    {"MSGOUT-UBX_NAV_VELNED_UART2",     0x20910044, FU1},
+    {"MSGOUT-UBX_NAV_VELNED_USB",       0x20910045, FU1},
+    {"MSGOUT-UBX_RXM_MEASX_I2C",        0x20910204, FU1},
+    {"MSGOUT-UBX_RXM_MEASX_SPI",        0x20910208, FU1},
+    {"MSGOUT-UBX_RXM_MEASX_UART1",      0x20910205, FU1},
+    {"MSGOUT-UBX_RXM_MEASX_UART2",      0x20910206, FU1},
+    {"MSGOUT-UBX_RXM_MEASX_USB",        0x20910207, FU1},
+    {"MSGOUT-UBX_RXM_RAWX_I2C",         0x209102a4, FU1},
+    {"MSGOUT-UBX_RXM_RAWX_SPI",         0x209102a8, FU1},
+    {"MSGOUT-UBX_RXM_RAWX_UART1",       0x209102a5, FU1},
+    {"MSGOUT-UBX_RXM_RAWX_UART2",       0x209102a6, FU1},
+    {"MSGOUT-UBX_RXM_RAWX_USB",         0x209102a7, FU1},
+    {"MSGOUT-UBX_RXM_RLM_I2C",          0x2091025e, FU1},
+    {"MSGOUT-UBX_RXM_RLM_SPI",          0x20910262, FU1},
+    {"MSGOUT-UBX_RXM_RLM_UART1",        0x2091025f, FU1},
+    {"MSGOUT-UBX_RXM_RLM_UART2",        0x20910260, FU1},
+    {"MSGOUT-UBX_RXM_RLM_USB",          0x20910261, FU1},
+    {"MSGOUT-UBX_RXM_RTCM_I2C",         0x20910268, FU1},
+    {"MSGOUT-UBX_RXM_RTCM_SPI",         0x2091026c, FU1},
+    {"MSGOUT-UBX_RXM_RTCM_UART1",       0x20910269, FU1},
+    {"MSGOUT-UBX_RXM_RTCM_UART2",       0x2091026a, FU1},
+    {"MSGOUT-UBX_RXM_RTCM_USB",         0x2091026b, FU1},
+    {"MSGOUT-UBX_RXM_SFRBX_I2C",        0x20910231, FU1},
+    {"MSGOUT-UBX_RXM_SFRBX_SPI",        0x20910235, FU1},
+    {"MSGOUT-UBX_RXM_SFRBX_UART1",      0x20910232, FU1},
+    {"MSGOUT-UBX_RXM_SFRBX_UART2",      0x20910233, FU1},
+    {"MSGOUT-UBX_RXM_SFRBX_USB",        0x20910234, FU1},
+    {"MSGOUT-UBX_TIM_SVIN_I2C",         0x20910097, FU1},
+    {"MSGOUT-UBX_TIM_SVIN_SPI",         0x2091009b, FU1},
+    {"MSGOUT-UBX_TIM_SVIN_UART1",       0x20910098, FU1},
+    {"MSGOUT-UBX_TIM_SVIN_UART2",       0x20910099, FU1},
+    {"MSGOUT-UBX_TIM_SVIN_USB",         0x2091009a, FU1},
+    {"MSGOUT-UBX_TIM_TM2_I2C",          0x20910178, FU1},
+    {"MSGOUT-UBX_TIM_TM2_SPI",          0x2091017c, FU1},
+    {"MSGOUT-UBX_TIM_TM2_UART1",        0x20910179, FU1},
+    {"MSGOUT-UBX_TIM_TM2_UART2",        0x2091017a, FU1},
+    {"MSGOUT-UBX_TIM_TM2_USB",          0x2091017b, FU1},
+    {"MSGOUT-UBX_TIM_TP_I2C",           0x2091017d, FU1},
+    {"MSGOUT-UBX_TIM_TP_SPI",           0x20910181, FU1},
+    {"MSGOUT-UBX_TIM_TP_UART1",         0x2091017e, FU1},
+    {"MSGOUT-UBX_TIM_TP_UART2",         0x2091017f, FU1},
+    {"MSGOUT-UBX_TIM_TP_USB",           0x20910180, FU1},
+    {"MSGOUT-UBX_TIM_VRFY_I2C",         0x20910092, FU1},
+    {"MSGOUT-UBX_TIM_VRFY_SPI",         0x20910096, FU1},
+    {"MSGOUT-UBX_TIM_VRFY_UART1",       0x20910093, FU1},
+    {"MSGOUT-UBX_TIM_VRFY_UART2",       0x20910094, FU1},
+    {"MSGOUT-UBX_TIM_VRFY_USB",         0x20910095, FU1},
+    {"NAVHPG-DGNSSMODE",                0x20140011, FU1},
+    {"NAVSPG-ACKAIDING",                0x10110025, FU1},
+    {"NAVSPG-CONSTR_ALT",               0x401100c1, FI4},
+    {"NAVSPG-CONSTR_ALTVAR",            0x401100c2, FU4},
+    {"NAVSPG-CONSTR_DGNSSTO",           0x201100c4, FU1},
+    {"NAVSPG-DYNMODEL",                 0x20110021, FU1},
+    {"NAVSPG-FIXMODE",                  0x20110011, FU1},
+    {"NAVSPG-INFIL_CNOTHRS",            0x201100ab, FU1},
+    {"NAVSPG-INFIL_MAXSVS",             0x201100a2, FU1},
+    {"NAVSPG-INFIL_MINCNO",             0x201100a3, FU1},
+    {"NAVSPG-INFIL_MINELEV",            0x201100a4, FI1},
+    {"NAVSPG-INFIL_MINSVS",             0x201100a1, FU1},
+    {"NAVSPG-INFIL_NCNOTHRS",           0x201100aa, FU1},
+    {"NAVSPG-INIFIX3D",                 0x10110013, FU1},
+    {"NAVSPG-OUTFIL_FACC",              0x301100b5, FU2},
+    {"NAVSPG-OUTFIL_PACC",              0x301100b3, FU2},
+    {"NAVSPG-OUTFIL_PDOP",              0x301100b1, FU2},
+    {"NAVSPG-OUTFIL_TACC",              0x301100b4, FU2},
+    {"NAVSPG-OUTFIL_TDOP",              0x301100b2, FU2},
+    {"NAVSPG-USE_PPP",                  0x10110019, FU1},
+    {"NAVSPG-USE_USRDAT",               0x10110061, FU1},
+    {"NAVSPG-USRDAT_DX",                0x40110064, FR4},
+    {"NAVSPG-USRDAT_DY",                0x40110065, FR4},
+    {"NAVSPG-USRDAT_DZ",                0x40110066, FR4},
+    {"NAVSPG-USRDAT_FLAT",              0x50110063, FR8},
+    {"NAVSPG-USRDAT_MAJA",              0x50110062, FR8},
+    {"NAVSPG-USRDAT_ROTX",              0x40110067, FR4},
+    {"NAVSPG-USRDAT_ROTY",              0x40110068, FR4},
+    {"NAVSPG-USRDAT_ROTZ",              0x40110069, FR4},
+    {"NAVSPG-USRDAT_SCALE",             0x4011006a, FR4},
+    {"NAVSPG-UTCSTANDARD",              0x2011001c, FU1},
+    {"NAVSPG-WKNROLLOVER",              0x30110017, FU2},
+    {"NMEA-BDSTALKERID",                0x30930033, FU2},
+    {"NMEA-COMPAT",                     0x10930003, FU1},
+    {"NMEA-CONSIDER",                   0x10930004, FU1},
+    {"NMEA-FILT_BDS",                   0x10930017, FU1},
+    {"NMEA-FILT_GLO",                   0x10930016, FU1},
+    {"NMEA-FILT_GPS",                   0x10930011, FU1},
+    {"NMEA-FILT_QZSS",                  0x10930015, FU1},
+    {"NMEA-FILT_SBAS",                  0x10930012, FU1},
+    {"NMEA-GSVTALKERID",                0x20930032, FU1},
+    {"NMEA-HIGHPREC",                   0x10930006, FU1},
+    {"NMEA-LIMIT82",                    0x10930005, FU1},
+    {"NMEA-MAINTALKERID",               0x20930031, FU1},
+    {"NMEA-MAXSVS",                     0x20930002, FU1},
+    {"NMEA-OUT_FROZENCOG",              0x10930026, FU1},
+    {"NMEA-OUT_INVDATE",                0x10930024, FU1},
+    {"NMEA-OUT_INVFIX",                 0x10930021, FU1},
+    {"NMEA-OUT_INVTIME",                0x10930023, FU1},
+    {"NMEA-OUT_MSKFIX",                 0x10930022, FU1},
+    {"NMEA-OUT_ONLYGPS",                0x10930025, FU1},
+    {"NMEA-PROTVER",                    0x20930001, FU1},
+    {"NMEA-SVNUMBERING",                0x20930007, FU1},
+    {"ODO-COGLPGAIN",                   0x20220032, FU1},
+    {"ODO-COGMAXPOSACC",                0x20220022, FU1},
+    {"ODO-COGMAXSPEED",                 0x20220021, FU1},
+    {"ODO-OUTLPCOG",                    0x10220004, FU1},
+    {"ODO-OUTLPVEL",                    0x10220003, FU1},
+    {"ODO-PROFILE",                     0x20220005, FU1},
+    {"ODO-USE_COG",                     0x10220002, FU1},
+    {"ODO-USE_ODO",                     0x10220001, FU1},
+    {"ODO-VELLPGAIN",                   0x20220031, FU1},
+    {"RATE-MEAS",                       0x30210001, FU2},
+    {"RATE-NAV",                        0x30210002, FU2},
+    {"RATE-TIMEREF",                    0x20210003, FU1},
+    {"RINV-BINARY",                     0x10c70002, FU1},
+    {"RINV-CHUNK0",                     0x50c70004, FU8},
+    {"RINV-CHUNK1",                     0x50c70005, FU8},
+    {"RINV-CHUNK2",                     0x50c70006, FU8},
+    {"RINV-CHUNK3",                     0x50c70007, FU8},
+    {"RINV-DATA_SIZE",                  0x20c70003, FU1},
+    {"RINV-DUMP",                       0x10c70001, FU1},
+    {"SBAS-PRNSCANMASK",                0x50360006, FU8},
+    {"SBAS-USE_DIFFCORR",               0x10360004, FU1},
+    {"SBAS-USE_INTEGRITY",              0x10360005, FU1},
+    {"SBAS-USE_RANGING",                0x10360003, FU1},
+    {"SBAS-USE_TESTMODE",               0x10360002, FU1},
+    {"SIGNAL-BDS_B1_ENA",               0x1031000d, FU1},
+    {"SIGNAL-BDS_B2_ENA",               0x1031000e, FU1},
+    {"SIGNAL-BDS_ENA",                  0x10310022, FU1},
+    {"SIGNAL-GAL_E1_ENA",               0x10310007, FU1},
+    {"SIGNAL-GAL_E5B_ENA",              0x1031000a, FU1},
+    {"SIGNAL-GAL_ENA",                  0x10310021, FU1},
+    {"SIGNAL-GLO_ENA",                  0x10310025, FU1},
+    {"SIGNAL-GLO_L1_ENA",               0x10310018, FU1},
+    {"SIGNAL-GLO_L2_ENA",               0x1031001a, FU1},
+    {"SIGNAL-GPS_ENA",                  0x1031001f, FU1},
+    {"SIGNAL-GPS_L1CA_ENA",             0x10310001, FU1},
+    {"SIGNAL-GPS_L2C_ENA",              0x10310003, FU1},
+    {"SIGNAL-QZSS_ENA",                 0x10310024, FU1},
+    {"SIGNAL-QZSS_L1CA_ENA",            0x10310012, FU1},
+    {"SIGNAL-QZSS_L1S_ENA",             0x10310014, FU1},
+    {"SIGNAL-QZSS_L2C_ENA",             0x10310015, FU1},
+    {"SIGNAL-SBAS_ENA",                 0x10310020, FU1},
+    {"SIGNAL-SBAS_L1CA_ENA",            0x10310005, FU1},
+    {"SPI-CPHASE",                      0x10640003, FU1},
+    {"SPI-CPOLARITY",                   0x10640002, FU1},
+    {"SPI-ENABLED",                     0x10640006, FU1},
+    {"SPI-EXTENDEDTIMEOUT",             0x10640005, FU1},
+    {"SPI-MAXFF",                       0x20640001, FU1},
+    {"SPIINPROT-NMEA",                  0x10790002, FU1},
+    {"SPIINPROT-RTCM2X",                0x10790003, FU1},
+    {"SPIINPROT-RTCM3X",                0x10790004, FU1},
+    {"SPIINPROT-UBX",                   0x10790001, FU1},
+    {"SPIOUTPROT-NMEA",                 0x107a0002, FU1},
+    {"SPIOUTPROT-RTCM3X",               0x107a0004, FU1},
+    {"SPIOUTPROT-UBX",                  0x107a0001, FU1},
+    {"TMODE-ECEF_X",                    0x40030003, FI4},
+    {"TMODE-ECEF_X_HP",                 0x20030006, FI1},
+    {"TMODE-ECEF_Y",                    0x40030004, FI4},
+    {"TMODE-ECEF_Y_HP",                 0x20030007, FI1},
+    {"TMODE-ECEF_Z",                    0x40030005, FI4},
+    {"TMODE-ECEF_Z_HP",                 0x20030008, FI1},
+    {"TMODE-FIXED_POS_ACC",             0x4003000f, FU4},
+    {"TMODE-HEIGHT",                    0x4003000b, FI4},
+    {"TMODE-HEIGHT_HP",                 0x2003000e, FI1},
+    {"TMODE-LAT",                       0x40030009, FI4},
+    {"TMODE-LAT_HP",                    0x2003000c, FI1},
+    {"TMODE-LON",                       0x4003000a, FI4},
+    {"TMODE-LON_HP",                    0x2003000d, FI1},
+    {"TMODE-MODE",                      0x20030001, FU1},
+    {"TMODE-POS_TYPE",                  0x20030002, FU1},
+    {"TMODE-SVIN_ACC_LIMIT",            0x40030011, FU4},
+    {"TMODE-SVIN_MIN_DUR",              0x40030010, FU4},
+    {"TP-ALIGN_TO_TOW_TP1",             0x1005000a, FU1},
+    {"TP-ALIGN_TO_TOW_TP2",             0x10050015, FU1},
+    {"TP-ANT_CABLEDELAY",               0x30050001, FI2},
+    {"TP-DUTY_LOCK_TP1",                0x5005002b, FR8},
+    {"TP-DUTY_LOCK_TP2",                0x5005002d, FR8},
+    {"TP-DUTY_TP1",                     0x5005002a, FR8},
+    {"TP-DUTY_TP2",                     0x5005002c, FR8},
+    {"TP-FREQ_LOCK_TP1",                0x40050025, FU4},
+    {"TP-FREQ_LOCK_TP2",                0x40050027, FU4},
+    {"TP-FREQ_TP1",                     0x40050024, FU4},
+    {"TP-FREQ_TP2",                     0x40050026, FU4},
+    {"TP-LEN_LOCK_TP1",                 0x40050005, FU4},
+    {"TP-LEN_LOCK_TP2",                 0x40050010, FU4},
+    {"TP-LEN_TP1",                      0x40050004, FU4},
+    {"TP-LEN_TP2",                      0x4005000f, FU4},
+    {"TP-PERIOD_LOCK_TP1",              0x40050003, FU4},
+    {"TP-PERIOD_LOCK_TP2",              0x4005000e, FU4},
+    {"TP-PERIOD_TP1",                   0x40050002, FU4},
+    {"TP-PERIOD_TP2",                   0x4005000d, FU4},
+    {"TP-POL_TP1",                      0x1005000b, FU1},
+    {"TP-POL_TP2",                      0x10050016, FU1},
+    {"TP-PULSE_DEF",                    0x20050023, FU1},
+    {"TP-PULSE_LENGTH_DEF",             0x20050030, FU1},
+    {"TP-SYNC_GNSS_TP1",                0x10050008, FU1},
+    {"TP-SYNC_GNSS_TP2",                0x10050013, FU1},
+    {"TP-TIMEGRID_TP1",                 0x2005000c, FU1},
+    {"TP-TIMEGRID_TP2",                 0x20050017, FU1},
+    {"TP-TP1_ENA",                      0x10050007, FU1},
+    {"TP-TP2_ENA",                      0x10050012, FU1},
+    {"TP-USER_DELAY_TP1",               0x40050006, FI4},
+    {"TP-USER_DELAY_TP2",               0x40050011, FI4},
+    {"TP-USE_LOCKED_TP1",               0x10050009, FU1},
+    {"TP-USE_LOCKED_TP2",               0x10050014, FU1},
+    {"UART1-BAUDRATE",                  0x40520001, FU4},
+    {"UART1-DATABITS",                  0x20520003, FU1},
+    {"UART1-ENABLED",                   0x10520005, FU1},
+    {"UART1-PARITY",                    0x20520004, FU1},
+    {"UART1-STOPBITS",                  0x20520002, FU1},
+    {"UART1INPROT-NMEA",                0x10730002, FU1},
+    {"UART1INPROT-RTCM2X",              0x10730003, FU1},
+    {"UART1INPROT-RTCM3X",              0x10730004, FU1},
+    {"UART1INPROT-UBX",                 0x10730001, FU1},
+    {"UART1OUTPROT-NMEA",               0x10740002, FU1},
+    {"UART1OUTPROT-RTCM3X",             0x10740004, FU1},
+    {"UART1OUTPROT-UBX",                0x10740001, FU1},
+    {"UART2-BAUDRATE",                  0x40530001, FU4},
+    {"UART2-DATABITS",                  0x20530003, FU1},
+    {"UART2-ENABLED",                   0x10530005, FU1},
+    {"UART2-PARITY",                    0x20530004, FU1},
+    {"UART2-REMAP",                     0x10530006, FU1},
+    {"UART2-STOPBITS",                  0x20530002, FU1},
+    {"UART2INPROT-NMEA",                0x10750002, FU1},
+    {"UART2INPROT-RTCM2X",              0x10750003, FU1},
+    {"UART2INPROT-RTCM3X",              0x10750004, FU1},
+    {"UART2INPROT-UBX",                 0x10750001, FU1},
+    {"UART2OUTPROT-NMEA",               0x10760002, FU1},
+    {"UART2OUTPROT-RTCM3X",             0x10760004, FU1},
+    {"UART2OUTPROT-UBX",                0x10760001, FU1},
+    {"USB-ENABLED",                     0x10650001, FU1},
+    {"USB-POWER",                       0x3065000c, FU2},
+    {"USB-PRODUCT_ID",                  0x3065000b, FU2},
+    {"USB-PRODUCT_STR0",                0x50650011, FU8},
+    {"USB-PRODUCT_STR1",                0x50650012, FU8},
+    {"USB-PRODUCT_STR2",                0x50650013, FU8},
+    {"USB-PRODUCT_STR3",                0x50650014, FU8},
+    {"USB-SELFPOW",                     0x10650002, FU1},
+    {"USB-SERIAL_NO_STR0",              0x50650015, FU8},
+    {"USB-SERIAL_NO_STR1",              0x50650016, FU8},
+    {"USB-SERIAL_NO_STR2",              0x50650017, FU8},
+    {"USB-SERIAL_NO_STR3",              0x50650018, FU8},
+    {"USB-VENDOR_ID",                   0x3065000a, FU2},
+    {"USB-VENDOR_STR0",                 0x5065000d, FU8},
+    {"USB-VENDOR_STR1",                 0x5065000e, FU8},
+    {"USB-VENDOR_STR2",                 0x5065000f, FU8},
+    {"USB-VENDOR_STR3",                 0x50650010, FU8},
+    {"USBINPROT-NMEA",                  0x10770002, FU1},
+    {"USBINPROT-RTCM2X",                0x10770003, FU1},
+    {"USBINPROT-RTCM3X",                0x10770004, FU1},
+    {"USBINPROT-UBX",                   0x10770001, FU1},
+    {"USBOUTPROT-NMEA",                 0x10780002, FU1},
+    {"USBOUTPROT-RTCM3X",               0x10780004, FU1},
+    {"USBOUTPROT-UBX",                  0x10780001, FU1},
+};
+
+#define VALSET_KEYS_LEN (sizeof(VALSET_KEYS) / sizeof(VALSET_KEYS[0]))
+
+/* tokens of a message string end at a space or at the end of the string ------*/
+static int tokcmp(const char *tok, const char *s)
+{
+    while (*tok && *tok != ' ' && *tok == *s)
+    {
+        tok++;
+        s++;
+    }
+    return (unsigned char)(*tok == ' ' ? '\0' : *tok) - (unsigned char)*s;
+}
+
+static int toklen32(const char *tok)
+{
+    size_t len = strcspn(tok, " ");
+    return len < 32 ? (int)len : 32;
+}
+
+/* bytes of a field in the binary message --------------------------------------*/
+static int field_len(int type)
+{
+    switch (type)
+    {
+    case FU2:
+    case FI2:
+        return 2;
+    case FU4:
+    case FI4:
+    case FR4:
+        return 4;
+    case FU8:
+    case FR8:
+        return 8;
+    case FS32:
+        return 32;
+    default:
+        return 1;
+    }
+}
+
+static int valset_key_cmp(const void *tok, const void *key)
+{
+    return tokcmp((const char *)tok, ((const ubx_valset_key_t *)key)->name);
+}
+
+/* find a VALSET key by name ("CFG-TMODE-MODE") or by id ("0x20030001") ------
+ * the value size of a key given by id is in bits 28-30 of the id
+ *-----------------------------------------------------------------------------*/
+static bool valset_key_find(const char *tok, uint32_t *key, int *type)
+{
+    static const int size_type[] = {0, FU1, FU1, FU2, FU4, FU8, 0, 0};
+    const ubx_valset_key_t *k;
+    char *end;
+
+    if (!strncmp(tok, "0x", 2) || !strncmp(tok, "0X", 2))
+    {
+        *key = (uint32_t)strtoul(tok, &end, 16);
+        *type = size_type[(*key >> 28) & 0x07];
+        return (*end == ' ' || *end == '\0') && *type;
+    }
+
+    if (strncmp(tok, "CFG-", 4))
+        return false;
+
+    k = bsearch(tok + 4, VALSET_KEYS, VALSET_KEYS_LEN, sizeof(ubx_valset_key_t), valset_key_cmp);
+    if (!k)
+        return false;
+
+    *key = k->id;
+    *type = k->type;
+    return true;
+}
+
 /* generate ublox binary message -----------------------------------------------
  * generate ublox binary message from message string
  * args   : char  *msg   IO     message string
@@ -209,13 +957,16 @@ static int stoi(const char *s)
  *            "CFG-VALDEL ver layer res0 res1 key [key ...]"
  *            "CFG-VALGET ver layer pos key [key ...]"
  *            "CFG-VALSET ver layer res0 res1 key value [key value ...]"
- *          uint8_t *buff O binary message
- * return : length of binary message (0: error)
+ *              key is CFG-name or key id (0xXXXXXXXX), value is decimal or hex
+ *          uint8_t *buff O binary message, UBX_FRAME_LEN_MAX bytes fit any
+ *                          VALSET of up to UBX_VALSET_KEYS_MAX pairs
+ *          uint32_t len  I size of buff
+ * return : length of binary message (0: error, or the message does not fit)
  * note   : see reference [1][3][5] for details.
  *          the following messages are not supported:
  *             CFG-DOSC,CFG-ESRC
  *-----------------------------------------------------------------------------*/
-uint32_t ubx_gen_cmd(const char *msg, uint8_t *buff)
+uint32_t ubx_gen_cmd(const char *msg, uint8_t *buff, uint32_t len)
 {
     static const char *cmd[] = {
         "PRT", "USB", "MSG", "NMEA", "RATE", "CFG", "TP", "NAV2", "DAT", "INF",
@@ -234,7 +985,7 @@ uint32_t ubx_gen_cmd(const char *msg, uint8_t *buff)
         0x36, 0x71, 0x31, 0x53,
         0x8c, 0x8b, 0x8a};
 
-    static const int prm[][32] = {
+    static const int prm[][UBX_FIELDS_MAX] = {
         {FU1, FU1, FU2, FU4, FU4, FU2, FU2, FU2, FU2},                                                                                 /* PRT */
         {FU2, FU2, FU2, FU2, FU2, FU2, FS32, FS32, FS32},                                                                              /* USB */
         {FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1},                                                                                      /* MSG */
@@ -274,31 +1025,35 @@ uint32_t ubx_gen_cmd(const char *msg, uint8_t *buff)
         {FU1, FU1, FU1, FU1}                                                                                                           /* VALSET */
     };
 
-    if (!msg || !buff)
+    if (!msg || !buff || len < UBX_HEADER_LEN + UBX_CHECKSUM_LEN)
     {
         return 0;
     }
 
     uint8_t *q = buff;
-    char mbuff[1024], *args[32], *p;
-    int i, j, n, narg = 0;
+    const char *args[UBX_ARGS_MAX], *p = msg;
+    int i, j, n, narg = 0, nval = 0;
     bool isvalset = false;
 
-    strcpy(mbuff, msg);
-
-    for (p = strtok(mbuff, " "); p && narg < 32; p = strtok(NULL, " "))
+    /* split on spaces without copying, each token ends at a space or at the end of msg */
+    while (narg < UBX_ARGS_MAX)
     {
+        p += strspn(p, " ");
+        if (!*p)
+            break;
         args[narg++] = p;
+        p += strcspn(p, " ");
     }
+    p += strspn(p, " ");
 
-    if (narg < 1 || strncmp(args[0], "CFG-", 4))
+    if (*p || narg < 1 || strncmp(args[0], "CFG-", 4))
     {
         return 0;
     }
 
     for (i = 0; *cmd[i]; i++)
     {
-        if (!strcmp(args[0] + 4, cmd[i]))
+        if (!tokcmp(args[0] + 4, cmd[i]))
             break;
     }
 
@@ -318,17 +1073,27 @@ uint32_t ubx_gen_cmd(const char *msg, uint8_t *buff)
         isvalset = true;
     }
 
-    /* VALSET sanity check */
+    /* VALSET sanity check: 4 header fields, then 1 to UBX_VALSET_KEYS_MAX key value pairs,
+       other commands have at most UBX_FIELDS_MAX - 1 fields, so that prm[i] is never read past its end */
     if (isvalset)
     {
-        if (narg == 7)
-            narg = narg - 2; /* Adjusting for key value addition */
+        nval = narg - 5;
+        if (nval >= 2 && nval % 2 == 0 && nval / 2 <= UBX_VALSET_KEYS_MAX)
+            narg = 5; /* key value pairs are added after the header */
         else
             return 0;
     }
+    else if (narg > UBX_FIELDS_MAX)
+    {
+        return 0;
+    }
 
     for (j = 1; prm[i][j - 1] || j < narg; j++)
     {
+        /* the field and the checksum must fit, the checksum also covers the NUL of a FS32 field */
+        if (q - buff + field_len(prm[i][j - 1]) + UBX_CHECKSUM_LEN > len)
+            return 0;
+
         switch (prm[i][j - 1])
         {
         case FU1:
@@ -364,7 +1129,7 @@ uint32_t ubx_gen_cmd(const char *msg, uint8_t *buff)
             q += 8;
             break;
         case FS32:
-            sprintf((char *)q, "%-32.32s", j < narg ? args[j] : "");
+            sprintf((char *)q, "%-32.*s", j < narg ? toklen32(args[j]) : 0, j < narg ? args[j] : "");
             q += 32;
             break;
         default:
@@ -375,898 +1140,42 @@ uint32_t ubx_gen_cmd(const char *msg, uint8_t *buff)
     }
 
     /* Add VALSET cfgData here */
-    if (isvalset)
+    for (; isvalset && j < 5 + nval; j += 2)
     {
-        int k;
-
-        /* VALSET commands courtesy of gpsd's ubxtool */
-        static const char *vcmd[] = {
-            "GEOFENCE-CONFLVL",
-            "GEOFENCE-USE_PIO",
-            "GEOFENCE-PINPOL",
-            "GEOFENCE-PIN",
-            "GEOFENCE-USE_FENCE1",
-            "GEOFENCE-FENCE1_LAT",
-            "GEOFENCE-FENCE1_LON",
-            "GEOFENCE-FENCE1_RAD",
-            "GEOFENCE-USE_FENCE2",
-            "GEOFENCE-FENCE2_LAT",
-            "GEOFENCE-FENCE2_LON",
-            "GEOFENCE-FENCE2_RAD",
-            "GEOFENCE-USE_FENCE3",
-            "GEOFENCE-FENCE3_LAT",
-            "GEOFENCE-FENCE3_LON",
-            "GEOFENCE-FENCE3_RAD",
-            "GEOFENCE-USE_FENCE4",
-            "GEOFENCE-FENCE4_LAT",
-            "GEOFENCE-FENCE4_LON",
-            "GEOFENCE-FENCE4_RAD",
-            "HW-ANT_CFG_VOLTCTRL",
-            "HW-ANT_CFG_SHORTDET",
-            "HW-ANT_CFG_SHORTDET_POL",
-            "HW-ANT_CFG_OPENDET",
-            "HW-ANT_CFG_OPENDET_POL",
-            "HW-ANT_CFG_PWRDOWN",
-            "HW-ANT_CFG_PWRDOWN_POL",
-            "HW-ANT_CFG_RECOVER",
-            "HW-ANT_SUP_SWITCH_PIN",
-            "HW-ANT_SUP_SHORT_PIN",
-            "HW-ANT_SUP_OPEN_PIN",
-            "I2C-ADDRESS",
-            "I2C-EXTENDEDTIMEOUT",
-            "I2C-ENABLED",
-            "I2CINPROT-UBX",
-            "I2CINPROT-NMEA",
-            "I2CINPROT-RTCM2X",
-            "I2CINPROT-RTCM3X",
-            "I2COUTPROT-UBX",
-            "I2COUTPROT-NMEA",
-            "I2COUTPROT-RTCM3X",
-            "INFMSG-UBX_I2C",
-            "INFMSG-UBX_UART1",
-            "INFMSG-UBX_UART2",
-            "INFMSG-UBX_USB",
-            "INFMSG-UBX_SPI",
-            "INFMSG-NMEA_I2C",
-            "INFMSG-NMEA_UART1",
-            "INFMSG-NMEA_UART2",
-            "INFMSG-NMEA_USB",
-            "INFMSG-NMEA_SPI",
-            "ITFM-BBTHRESHOLD",
-            "ITFM-CWTHRESHOLD",
-            "ITFM-ENABLE",
-            "ITFM-ANTSETTING",
-            "ITFM-ENABLE_AUX",
-            "LOGFILTER-RECORD_ENA",
-            "LOGFILTER-ONCE_PER_WAKE_UP_ENA",
-            "LOGFILTER-APPLY_ALL_FILTERS",
-            "LOGFILTER-MIN_INTERVAL",
-            "LOGFILTER-TIME_THRS",
-            "LOGFILTER-SPEED_THRS",
-            "LOGFILTER-POSITION_THRS",
-            "MOT-GNSSSPEED_THRS",
-            "MOT-GNSSDIST_THRS",
-            "MSGOUT-NMEA_ID_DTM_I2C",
-            "MSGOUT-NMEA_ID_DTM_SPI",
-            "MSGOUT-NMEA_ID_DTM_UART1",
-            "MSGOUT-NMEA_ID_DTM_UART2",
-            "MSGOUT-NMEA_ID_DTM_USB",
-            "MSGOUT-NMEA_ID_GBS_I2C",
-            "MSGOUT-NMEA_ID_GBS_SPI",
-            "MSGOUT-NMEA_ID_GBS_UART1",
-            "MSGOUT-NMEA_ID_GBS_UART2",
-            "MSGOUT-NMEA_ID_GBS_USB",
-            "MSGOUT-NMEA_ID_GGA_I2C",
-            "MSGOUT-NMEA_ID_GGA_SPI",
-            "MSGOUT-NMEA_ID_GGA_UART1",
-            "MSGOUT-NMEA_ID_GGA_UART2",
-            "MSGOUT-NMEA_ID_GGA_USB",
-            "MSGOUT-NMEA_ID_GLL_I2C",
-            "MSGOUT-NMEA_ID_GLL_SPI",
-            "MSGOUT-NMEA_ID_GLL_UART1",
-            "MSGOUT-NMEA_ID_GLL_UART2",
-            "MSGOUT-NMEA_ID_GLL_USB",
-            "MSGOUT-NMEA_ID_GNS_I2C",
-            "MSGOUT-NMEA_ID_GNS_SPI",
-            "MSGOUT-NMEA_ID_GNS_UART1",
-            "MSGOUT-NMEA_ID_GNS_UART2",
-            "MSGOUT-NMEA_ID_GNS_USB",
-            "MSGOUT-NMEA_ID_GRS_I2C",
-            "MSGOUT-NMEA_ID_GRS_SPI",
-            "MSGOUT-NMEA_ID_GRS_UART1",
-            "MSGOUT-NMEA_ID_GRS_UART2",
-            "MSGOUT-NMEA_ID_GRS_USB",
-            "MSGOUT-NMEA_ID_GSA_I2C",
-            "MSGOUT-NMEA_ID_GSA_SPI",
-            "MSGOUT-NMEA_ID_GSA_UART1",
-            "MSGOUT-NMEA_ID_GSA_UART2",
-            "MSGOUT-NMEA_ID_GSA_USB",
-            "MSGOUT-NMEA_ID_GST_I2C",
-            "MSGOUT-NMEA_ID_GST_SPI",
-            "MSGOUT-NMEA_ID_GST_UART1",
-            "MSGOUT-NMEA_ID_GST_UART2",
-            "MSGOUT-NMEA_ID_GST_USB",
-            "MSGOUT-NMEA_ID_GSV_I2C",
-            "MSGOUT-NMEA_ID_GSV_SPI",
-            "MSGOUT-NMEA_ID_GSV_UART1",
-            "MSGOUT-NMEA_ID_GSV_UART2",
-            "MSGOUT-NMEA_ID_GSV_USB",
-            "MSGOUT-NMEA_ID_RMC_I2C",
-            "MSGOUT-NMEA_ID_RMC_SPI",
-            "MSGOUT-NMEA_ID_RMC_UART1",
-            "MSGOUT-NMEA_ID_RMC_UART2",
-            "MSGOUT-NMEA_ID_RMC_USB",
-            "MSGOUT-NMEA_ID_VLW_I2C",
-            "MSGOUT-NMEA_ID_VLW_SPI",
-            "MSGOUT-NMEA_ID_VLW_UART1",
-            "MSGOUT-NMEA_ID_VLW_UART2",
-            "MSGOUT-NMEA_ID_VLW_USB",
-            "MSGOUT-NMEA_ID_VTG_I2C",
-            "MSGOUT-NMEA_ID_VTG_SPI",
-            "MSGOUT-NMEA_ID_VTG_UART1",
-            "MSGOUT-NMEA_ID_VTG_UART2",
-            "MSGOUT-NMEA_ID_VTG_USB",
-            "MSGOUT-NMEA_ID_ZDA_I2C",
-            "MSGOUT-NMEA_ID_ZDA_SPI",
-            "MSGOUT-NMEA_ID_ZDA_UART1",
-            "MSGOUT-NMEA_ID_ZDA_UART2",
-            "MSGOUT-NMEA_ID_ZDA_USB",
-            "MSGOUT-PUBX_ID_POLYP_I2C",
-            "MSGOUT-PUBX_ID_POLYP_SPI",
-            "MSGOUT-PUBX_ID_POLYP_UART1",
-            "MSGOUT-PUBX_ID_POLYP_UART2",
-            "MSGOUT-PUBX_ID_POLYP_USB",
-            "MSGOUT-PUBX_ID_POLYS_I2C",
-            "MSGOUT-PUBX_ID_POLYS_SPI",
-            "MSGOUT-PUBX_ID_POLYS_UART1",
-            "MSGOUT-PUBX_ID_POLYS_UART2",
-            "MSGOUT-PUBX_ID_POLYS_USB",
-            "MSGOUT-PUBX_ID_POLYT_I2C",
-            "MSGOUT-PUBX_ID_POLYT_SPI",
-            "MSGOUT-PUBX_ID_POLYT_UART1",
-            "MSGOUT-PUBX_ID_POLYT_UART2",
-            "MSGOUT-PUBX_ID_POLYT_USB",
-            "MSGOUT-RTCM_3X_TYPE1005_I2C",
-            "MSGOUT-RTCM_3X_TYPE1005_SPI",
-            "MSGOUT-RTCM_3X_TYPE1005_UART1",
-            "MSGOUT-RTCM_3X_TYPE1005_UART2",
-            "MSGOUT-RTCM_3X_TYPE1005_USB",
-            "MSGOUT-RTCM_3X_TYPE1074_I2C",
-            "MSGOUT-RTCM_3X_TYPE1074_SPI",
-            "MSGOUT-RTCM_3X_TYPE1074_UART1",
-            "MSGOUT-RTCM_3X_TYPE1074_UART2",
-            "MSGOUT-RTCM_3X_TYPE1074_USB",
-            "MSGOUT-RTCM_3X_TYPE1077_I2C",
-            "MSGOUT-RTCM_3X_TYPE1077_SPI",
-            "MSGOUT-RTCM_3X_TYPE1077_UART1",
-            "MSGOUT-RTCM_3X_TYPE1077_UART2",
-            "MSGOUT-RTCM_3X_TYPE1077_USB",
-            "MSGOUT-RTCM_3X_TYPE1087_I2C",
-            "MSGOUT-RTCM_3X_TYPE1084_SPI",
-            "MSGOUT-RTCM_3X_TYPE1084_UART1",
-            "MSGOUT-RTCM_3X_TYPE1084_UART2",
-            "MSGOUT-RTCM_3X_TYPE1084_USB",
-            "MSGOUT-RTCM_3X_TYPE1087_SPI",
-            "MSGOUT-RTCM_3X_TYPE1087_UART1",
-            "MSGOUT-RTCM_3X_TYPE1087_UART2",
-            "MSGOUT-RTCM_3X_TYPE1087_USB",
-            "MSGOUT-RTCM_3X_TYPE1094_I2C",
-            "MSGOUT-RTCM_3X_TYPE1094_SPI",
-            "MSGOUT-RTCM_3X_TYPE1094_UART1",
-            "MSGOUT-RTCM_3X_TYPE1094_UART2",
-            "MSGOUT-RTCM_3X_TYPE1094_USB",
-            "MSGOUT-RTCM_3X_TYPE1097_I2C",
-            "MSGOUT-RTCM_3X_TYPE1097_SPI",
-            "MSGOUT-RTCM_3X_TYPE1097_UART1",
-            "MSGOUT-RTCM_3X_TYPE1097_UART2",
-            "MSGOUT-RTCM_3X_TYPE1097_USB",
-            "MSGOUT-RTCM_3X_TYPE1124_I2C",
-            "MSGOUT-RTCM_3X_TYPE1124_SPI",
-            "MSGOUT-RTCM_3X_TYPE1124_UART1",
-            "MSGOUT-RTCM_3X_TYPE1124_UART2",
-            "MSGOUT-RTCM_3X_TYPE1124_USB",
-            "MSGOUT-RTCM_3X_TYPE1127_I2C",
-            "MSGOUT-RTCM_3X_TYPE1127_SPI",
-            "MSGOUT-RTCM_3X_TYPE1127_UART1",
-            "MSGOUT-RTCM_3X_TYPE1127_UART2",
-            "MSGOUT-RTCM_3X_TYPE1127_USB",
-            "MSGOUT-RTCM_3X_TYPE1230_I2C",
-            "MSGOUT-RTCM_3X_TYPE1230_SPI",
-            "MSGOUT-RTCM_3X_TYPE1230_UART1",
-            "MSGOUT-RTCM_3X_TYPE1230_UART2",
-            "MSGOUT-RTCM_3X_TYPE1230_USB",
-            "MSGOUT-RTCM_3X_TYPE4072_0_I2C",
-            "MSGOUT-RTCM_3X_TYPE4072_0_SPI",
-            "MSGOUT-RTCM_3X_TYPE4072_0_UART1",
-            "MSGOUT-RTCM_3X_TYPE4072_0_UART2",
-            "MSGOUT-RTCM_3X_TYPE4072_0_USB",
-            "MSGOUT-RTCM_3X_TYPE4072_1_I2C",
-            "MSGOUT-RTCM_3X_TYPE4072_1_SPI",
-            "MSGOUT-RTCM_3X_TYPE4072_1_UART1",
-            "MSGOUT-RTCM_3X_TYPE4072_1_UART2",
-            "MSGOUT-RTCM_3X_TYPE4072_1_USB",
-            "MSGOUT-UBX_LOG_INFO_I2C",
-            "MSGOUT-UBX_LOG_INFO_SPI",
-            "MSGOUT-UBX_LOG_INFO_UART1",
-            "MSGOUT-UBX_LOG_INFO_UART2",
-            "MSGOUT-UBX_LOG_INFO_USB",
-            "MSGOUT-UBX_MON_COMMS_I2C",
-            "MSGOUT-UBX_MON_COMMS_SPI",
-            "MSGOUT-UBX_MON_COMMS_UART1",
-            "MSGOUT-UBX_MON_COMMS_UART2",
-            "MSGOUT-UBX_MON_COMMS_USB",
-            "MSGOUT-UBX_MON_HW2_I2C",
-            "MSGOUT-UBX_MON_HW2_SPI",
-            "MSGOUT-UBX_MON_HW2_UART1",
-            "MSGOUT-UBX_MON_HW2_UART2",
-            "MSGOUT-UBX_MON_HW2_USB",
-            "MSGOUT-UBX_MON_HW3_I2C",
-            "MSGOUT-UBX_MON_HW3_SPI",
-            "MSGOUT-UBX_MON_HW3_UART1",
-            "MSGOUT-UBX_MON_HW3_UART2",
-            "MSGOUT-UBX_MON_HW3_USB",
-            "MSGOUT-UBX_MON_HW_I2C",
-            "MSGOUT-UBX_MON_HW_SPI",
-            "MSGOUT-UBX_MON_HW_UART1",
-            "MSGOUT-UBX_MON_HW_UART2",
-            "MSGOUT-UBX_MON_HW_USB",
-            "MSGOUT-UBX_MON_IO_I2C",
-            "MSGOUT-UBX_MON_IO_SPI",
-            "MSGOUT-UBX_MON_IO_UART1",
-            "MSGOUT-UBX_MON_IO_UART2",
-            "MSGOUT-UBX_MON_IO_USB",
-            "MSGOUT-UBX_MON_MSGPP_I2C",
-            "MSGOUT-UBX_MON_MSGPP_SPI",
-            "MSGOUT-UBX_MON_MSGPP_UART1",
-            "MSGOUT-UBX_MON_MSGPP_UART2",
-            "MSGOUT-UBX_MON_MSGPP_USB",
-            "MSGOUT-UBX_MON_RF_I2C",
-            "MSGOUT-UBX_MON_RF_SPI",
-            "MSGOUT-UBX_MON_RF_UART1",
-            "MSGOUT-UBX_MON_RF_UART2",
-            "MSGOUT-UBX_MON_RF_USB",
-            "MSGOUT-UBX_MON_RXBUF_I2C",
-            "MSGOUT-UBX_MON_RXBUF_SPI",
-            "MSGOUT-UBX_MON_RXBUF_UART1",
-            "MSGOUT-UBX_MON_RXBUF_UART2",
-            "MSGOUT-UBX_MON_RXBUF_USB",
-            "MSGOUT-UBX_MON_RXR_I2C",
-            "MSGOUT-UBX_MON_RXR_SPI",
-            "MSGOUT-UBX_MON_RXR_UART1",
-            "MSGOUT-UBX_MON_RXR_UART2",
-            "MSGOUT-UBX_MON_RXR_USB",
-            "MSGOUT-UBX_MON_TXBUF_I2C",
-            "MSGOUT-UBX_MON_TXBUF_SPI",
-            "MSGOUT-UBX_MON_TXBUF_UART1",
-            "MSGOUT-UBX_MON_TXBUF_UART2",
-            "MSGOUT-UBX_MON_TXBUF_USB",
-            "MSGOUT-UBX_MON_TXBUF_I2C",
-            "MSGOUT-UBX_MON_TXBUF_SPI",
-            "MSGOUT-UBX_MON_TXBUF_UART1",
-            "MSGOUT-UBX_MON_TXBUF_UART2",
-            "MSGOUT-UBX_MON_TXBUF_USB",
-            "MSGOUT-UBX_NAV_CLOCK_I2C",
-            "MSGOUT-UBX_NAV_CLOCK_SPI",
-            "MSGOUT-UBX_NAV_CLOCK_UART1",
-            "MSGOUT-UBX_NAV_CLOCK_UART2",
-            "MSGOUT-UBX_NAV_CLOCK_USB",
-            "MSGOUT-UBX_NAV_DOP_I2C",
-            "MSGOUT-UBX_NAV_DOP_SPI",
-            "MSGOUT-UBX_NAV_DOP_UART1",
-            "MSGOUT-UBX_NAV_DOP_UART2",
-            "MSGOUT-UBX_NAV_DOP_USB",
-            "MSGOUT-UBX_NAV_EOE_I2C",
-            "MSGOUT-UBX_NAV_EOE_SPI",
-            "MSGOUT-UBX_NAV_EOE_UART1",
-            "MSGOUT-UBX_NAV_EOE_UART2",
-            "MSGOUT-UBX_NAV_EOE_USB",
-            "MSGOUT-UBX_NAV_GEOFENCE_I2C",
-            "MSGOUT-UBX_NAV_GEOFENCE_SPI",
-            "MSGOUT-UBX_NAV_GEOFENCE_UART1",
-            "MSGOUT-UBX_NAV_GEOFENCE_UART2",
-            "MSGOUT-UBX_NAV_GEOFENCE_USB",
-            "MSGOUT-UBX_NAV_HPPOSECEF_I2C",
-            "MSGOUT-UBX_NAV_HPPOSECEF_SPI",
-            "MSGOUT-UBX_NAV_HPPOSECEF_UART1",
-            "MSGOUT-UBX_NAV_HPPOSECEF_UART2",
-            "MSGOUT-UBX_NAV_HPPOSECEF_USB",
-            "MSGOUT-UBX_NAV_HPPOSLLH_I2C",
-            "MSGOUT-UBX_NAV_HPPOSLLH_SPI",
-            "MSGOUT-UBX_NAV_HPPOSLLH_UART1",
-            "MSGOUT-UBX_NAV_HPPOSLLH_UART2",
-            "MSGOUT-UBX_NAV_HPPOSLLH_USB",
-            "MSGOUT-UBX_NAV_ODO_I2C",
-            "MSGOUT-UBX_NAV_ODO_SPI",
-            "MSGOUT-UBX_NAV_ODO_UART1",
-            "MSGOUT-UBX_NAV_ODO_UART2",
-            "MSGOUT-UBX_NAV_ODO_USB",
-            "MSGOUT-UBX_NAV_ORB_I2C",
-            "MSGOUT-UBX_NAV_ORB_SPI",
-            "MSGOUT-UBX_NAV_ORB_UART1",
-            "MSGOUT-UBX_NAV_ORB_UART2",
-            "MSGOUT-UBX_NAV_ORB_USB",
-            "MSGOUT-UBX_NAV_POSECEF_I2C",
-            "MSGOUT-UBX_NAV_POSECEF_SPI",
-            "MSGOUT-UBX_NAV_POSECEF_UART1",
-            "MSGOUT-UBX_NAV_POSECEF_UART2",
-            "MSGOUT-UBX_NAV_POSECEF_USB",
-            "MSGOUT-UBX_NAV_POSLLH_I2C",
-            "MSGOUT-UBX_NAV_POSLLH_SPI",
-            "MSGOUT-UBX_NAV_POSLLH_UART1",
-            "MSGOUT-UBX_NAV_POSLLH_UART2",
-            "MSGOUT-UBX_NAV_POSLLH_USB",
-            "MSGOUT-UBX_NAV_PVT_I2C",
-            "MSGOUT-UBX_NAV_PVT_SPI",
-            "MSGOUT-UBX_NAV_PVT_UART1",
-            "MSGOUT-UBX_NAV_PVT_UART2",
-            "MSGOUT-UBX_NAV_PVT_USB",
-            "MSGOUT-UBX_NAV_RELPOSNED_I2C",
-            "MSGOUT-UBX_NAV_RELPOSNED_SPI",
-            "MSGOUT-UBX_NAV_RELPOSNED_UART1",
-            "MSGOUT-UBX_NAV_RELPOSNED_UART2",
-            "MSGOUT-UBX_NAV_RELPOSNED_USB",
-            "MSGOUT-UBX_NAV_SAT_I2C",
-            "MSGOUT-UBX_NAV_SAT_SPI",
-            "MSGOUT-UBX_NAV_SAT_UART1",
-            "MSGOUT-UBX_NAV_SAT_UART2",
-            "MSGOUT-UBX_NAV_SAT_USB",
-            "MSGOUT-UBX_NAV_SBAS_I2C",
-            "MSGOUT-UBX_NAV_SBAS_SPI",
-            "MSGOUT-UBX_NAV_SBAS_UART1",
-            "MSGOUT-UBX_NAV_SBAS_UART2",
-            "MSGOUT-UBX_NAV_SBAS_USB",
-            "MSGOUT-UBX_NAV_SIG_I2C",
-            "MSGOUT-UBX_NAV_SIG_SPI",
-            "MSGOUT-UBX_NAV_SIG_UART1",
-            "MSGOUT-UBX_NAV_SIG_UART2",
-            "MSGOUT-UBX_NAV_SIG_USB",
-            "MSGOUT-UBX_NAV_STATUS_I2C",
-            "MSGOUT-UBX_NAV_STATUS_SPI",
-            "MSGOUT-UBX_NAV_STATUS_UART1",
-            "MSGOUT-UBX_NAV_STATUS_UART2",
-            "MSGOUT-UBX_NAV_STATUS_USB",
-            "MSGOUT-UBX_NAV_SVIN_I2C",
-            "MSGOUT-UBX_NAV_SVIN_SPI",
-            "MSGOUT-UBX_NAV_SVIN_UART1",
-            "MSGOUT-UBX_NAV_SVIN_UART2",
-            "MSGOUT-UBX_NAV_SVIN_USB",
-            "MSGOUT-UBX_NAV_TIMEBDS_I2C",
-            "MSGOUT-UBX_NAV_TIMEBDS_SPI",
-            "MSGOUT-UBX_NAV_TIMEBDS_UART1",
-            "MSGOUT-UBX_NAV_TIMEBDS_UART2",
-            "MSGOUT-UBX_NAV_TIMEBDS_USB",
-            "MSGOUT-UBX_NAV_TIMEGAL_I2C",
-            "MSGOUT-UBX_NAV_TIMEGAL_SPI",
-            "MSGOUT-UBX_NAV_TIMEGAL_UART1",
-            "MSGOUT-UBX_NAV_TIMEGAL_UART2",
-            "MSGOUT-UBX_NAV_TIMEGAL_USB",
-            "MSGOUT-UBX_NAV_TIMEGLO_I2C",
-            "MSGOUT-UBX_NAV_TIMEGLO_SPI",
-            "MSGOUT-UBX_NAV_TIMEGLO_UART1",
-            "MSGOUT-UBX_NAV_TIMEGLO_UART2",
-            "MSGOUT-UBX_NAV_TIMEGLO_USB",
-            "MSGOUT-UBX_NAV_TIMEGPS_I2C",
-            "MSGOUT-UBX_NAV_TIMEGPS_SPI",
-            "MSGOUT-UBX_NAV_TIMEGPS_UART1",
-            "MSGOUT-UBX_NAV_TIMEGPS_UART2",
-            "MSGOUT-UBX_NAV_TIMEGPS_USB",
-            "MSGOUT-UBX_NAV_TIMELS_I2C",
-            "MSGOUT-UBX_NAV_TIMELS_SPI",
-            "MSGOUT-UBX_NAV_TIMELS_UART1",
-            "MSGOUT-UBX_NAV_TIMELS_UART2",
-            "MSGOUT-UBX_NAV_TIMELS_USB",
-            "MSGOUT-UBX_NAV_TIMEUTC_I2C",
-            "MSGOUT-UBX_NAV_TIMEUTC_SPI",
-            "MSGOUT-UBX_NAV_TIMEUTC_UART1",
-            "MSGOUT-UBX_NAV_TIMEUTC_UART2",
-            "MSGOUT-UBX_NAV_TIMEUTC_USB",
-            "MSGOUT-UBX_NAV_VELECEF_I2C",
-            "MSGOUT-UBX_NAV_VELECEF_SPI",
-            "MSGOUT-UBX_NAV_VELECEF_UART1",
-            "MSGOUT-UBX_NAV_VELECEF_UART2",
-            "MSGOUT-UBX_NAV_VELECEF_USB",
-            "MSGOUT-UBX_NAV_VELNED_I2C",
-            "MSGOUT-UBX_NAV_VELNED_SPI",
-            "MSGOUT-UBX_NAV_VELNED_UART1",
-            "MSGOUT-UBX_NAV_VELNED_UART2",
-            "MSGOUT-UBX_NAV_VELNED_USB",
-            "MSGOUT-UBX_RXM_MEASX_I2C",
-            "MSGOUT-UBX_RXM_MEASX_SPI",
-            "MSGOUT-UBX_RXM_MEASX_UART1",
-            "MSGOUT-UBX_RXM_MEASX_UART2",
-            "MSGOUT-UBX_RXM_MEASX_USB",
-            "MSGOUT-UBX_RXM_RAWX_I2C",
-            "MSGOUT-UBX_RXM_RAWX_SPI",
-            "MSGOUT-UBX_RXM_RAWX_UART1",
-            "MSGOUT-UBX_RXM_RAWX_UART2",
-            "MSGOUT-UBX_RXM_RAWX_USB",
-            "MSGOUT-UBX_RXM_RLM_I2C",
-            "MSGOUT-UBX_RXM_RLM_SPI",
-            "MSGOUT-UBX_RXM_RLM_UART1",
-            "MSGOUT-UBX_RXM_RLM_UART2",
-            "MSGOUT-UBX_RXM_RLM_USB",
-            "MSGOUT-UBX_RXM_RTCM_I2C",
-            "MSGOUT-UBX_RXM_RTCM_SPI",
-            "MSGOUT-UBX_RXM_RTCM_UART1",
-            "MSGOUT-UBX_RXM_RTCM_UART2",
-            "MSGOUT-UBX_RXM_RTCM_USB",
-            "MSGOUT-UBX_RXM_SFRBX_I2C",
-            "MSGOUT-UBX_RXM_SFRBX_SPI",
-            "MSGOUT-UBX_RXM_SFRBX_UART1",
-            "MSGOUT-UBX_RXM_SFRBX_UART2",
-            "MSGOUT-UBX_RXM_SFRBX_USB",
-            "MSGOUT-UBX_TIM_SVIN_I2C",
-            "MSGOUT-UBX_TIM_SVIN_SPI",
-            "MSGOUT-UBX_TIM_SVIN_UART1",
-            "MSGOUT-UBX_TIM_SVIN_UART2",
-            "MSGOUT-UBX_TIM_SVIN_USB",
-            "MSGOUT-UBX_TIM_TM2_I2C",
-            "MSGOUT-UBX_TIM_TM2_SPI",
-            "MSGOUT-UBX_TIM_TM2_UART1",
-            "MSGOUT-UBX_TIM_TM2_UART2",
-            "MSGOUT-UBX_TIM_TM2_USB",
-            "MSGOUT-UBX_TIM_TP_I2C",
-            "MSGOUT-UBX_TIM_TP_SPI",
-            "MSGOUT-UBX_TIM_TP_UART1",
-            "MSGOUT-UBX_TIM_TP_UART2",
-            "MSGOUT-UBX_TIM_TP_USB",
-            "MSGOUT-UBX_TIM_VRFY_I2C",
-            "MSGOUT-UBX_TIM_VRFY_SPI",
-            "MSGOUT-UBX_TIM_VRFY_UART1",
-            "MSGOUT-UBX_TIM_VRFY_UART2",
-            "MSGOUT-UBX_TIM_VRFY_USB",
-            "NAVHPG-DGNSSMODE",
-            "NAVSPG-FIXMODE",
-            "NAVSPG-INIFIX3D",
-            "NAVSPG-WKNROLLOVER",
-            "NAVSPG-USE_PPP",
-            "NAVSPG-UTCSTANDARD",
-            "NAVSPG-DYNMODEL",
-            "NAVSPG-ACKAIDING",
-            "NAVSPG-USE_USRDAT",
-            "NAVSPG-USRDAT_MAJA",
-            "NAVSPG-USRDAT_FLAT",
-            "NAVSPG-USRDAT_DX",
-            "NAVSPG-USRDAT_DY",
-            "NAVSPG-USRDAT_DZ",
-            "NAVSPG-USRDAT_ROTX",
-            "NAVSPG-USRDAT_ROTY",
-            "NAVSPG-USRDAT_ROTZ",
-            "NAVSPG-USRDAT_SCALE",
-            "NAVSPG-INFIL_MINSVS",
-            "NAVSPG-INFIL_MAXSVS",
-            "NAVSPG-INFIL_MINCNO",
-            "NAVSPG-INFIL_MINELEV",
-            "NAVSPG-INFIL_NCNOTHRS",
-            "NAVSPG-INFIL_CNOTHRS",
-            "NAVSPG-OUTFIL_PDOP",
-            "NAVSPG-OUTFIL_TDOP",
-            "NAVSPG-OUTFIL_PACC",
-            "NAVSPG-OUTFIL_TACC",
-            "NAVSPG-OUTFIL_FACC",
-            "NAVSPG-CONSTR_ALT",
-            "NAVSPG-CONSTR_ALTVAR",
-            "NAVSPG-CONSTR_DGNSSTO",
-            "NMEA-PROTVER",
-            "NMEA-MAXSVS",
-            "NMEA-COMPAT",
-            "NMEA-CONSIDER",
-            "NMEA-LIMIT82",
-            "NMEA-HIGHPREC",
-            "NMEA-SVNUMBERING",
-            "NMEA-FILT_GPS",
-            "NMEA-FILT_SBAS",
-            "NMEA-FILT_QZSS",
-            "NMEA-FILT_GLO",
-            "NMEA-FILT_BDS",
-            "NMEA-OUT_INVFIX",
-            "NMEA-OUT_MSKFIX",
-            "NMEA-OUT_INVTIME",
-            "NMEA-OUT_INVDATE",
-            "NMEA-OUT_ONLYGPS",
-            "NMEA-OUT_FROZENCOG",
-            "NMEA-MAINTALKERID",
-            "NMEA-GSVTALKERID",
-            "NMEA-BDSTALKERID",
-            "ODO-USE_ODO",
-            "ODO-USE_COG",
-            "ODO-OUTLPVEL",
-            "ODO-OUTLPCOG",
-            "ODO-PROFILE",
-            "ODO-COGMAXSPEED",
-            "ODO-COGMAXPOSACC",
-            "ODO-COGLPGAIN",
-            "ODO-VELLPGAIN",
-            "RATE-MEAS",
-            "RATE-NAV",
-            "RATE-TIMEREF",
-            "RINV-DUMP",
-            "RINV-BINARY",
-            "RINV-DATA_SIZE",
-            "RINV-CHUNK0",
-            "RINV-CHUNK1",
-            "RINV-CHUNK2",
-            "RINV-CHUNK3",
-            "SBAS-USE_TESTMODE",
-            "SBAS-USE_RANGING",
-            "SBAS-USE_DIFFCORR",
-            "SBAS-USE_INTEGRITY",
-            "SBAS-PRNSCANMASK",
-            "SIGNAL-GPS_ENA",
-            "SIGNAL-GPS_L1CA_ENA",
-            "SIGNAL-GPS_L2C_ENA",
-            "SIGNAL-SBAS_ENA",
-            "SIGNAL-SBAS_L1CA_ENA",
-            "SIGNAL-GAL_ENA",
-            "SIGNAL-GAL_E1_ENA",
-            "SIGNAL-GAL_E5B_ENA",
-            "SIGNAL-BDS_ENA",
-            "SIGNAL-BDS_B1_ENA",
-            "SIGNAL-BDS_B2_ENA",
-            "SIGNAL-QZSS_ENA",
-            "SIGNAL-QZSS_L1CA_ENA",
-            "SIGNAL-QZSS_L1S_ENA",
-            "SIGNAL-QZSS_L2C_ENA",
-            "SIGNAL-GLO_ENA",
-            "SIGNAL-GLO_L1_ENA",
-            "SIGNAL-GLO_L2_ENA",
-            "SPI-MAXFF",
-            "SPI-CPOLARITY",
-            "SPI-CPHASE",
-            "SPI-EXTENDEDTIMEOUT",
-            "SPI-ENABLED",
-            "SPIINPROT-UBX",
-            "SPIINPROT-NMEA",
-            "SPIINPROT-RTCM2X",
-            "SPIINPROT-RTCM3X",
-            "SPIOUTPROT-UBX",
-            "SPIOUTPROT-NMEA",
-            "SPIOUTPROT-RTCM3X",
-            "TMODE-MODE",
-            "TMODE-POS_TYPE",
-            "TMODE-ECEF_X",
-            "TMODE-ECEF_Y",
-            "TMODE-ECEF_Z",
-            "TMODE-ECEF_X_HP",
-            "TMODE-ECEF_Y_HP",
-            "TMODE-ECEF_Z_HP",
-            "TMODE-LAT",
-            "TMODE-LON",
-            "TMODE-HEIGHT",
-            "TMODE-LAT_HP",
-            "TMODE-LON_HP",
-            "TMODE-HEIGHT_HP",
-            "TMODE-FIXED_POS_ACC",
-            "TMODE-SVIN_MIN_DUR",
-            "TMODE-SVIN_ACC_LIMIT",
-            "TP-PULSE_DEF",
-            "TP-PULSE_LENGTH_DEF",
-            "TP-ANT_CABLEDELAY",
-            "TP-PERIOD_TP1",
-            "TP-PERIOD_LOCK_TP1",
-            "TP-FREQ_TP1",
-            "TP-FREQ_LOCK_TP1",
-            "TP-LEN_TP1",
-            "TP-LEN_LOCK_TP1",
-            "TP-DUTY_TP1",
-            "TP-DUTY_LOCK_TP1",
-            "TP-USER_DELAY_TP1",
-            "TP-TP1_ENA",
-            "TP-SYNC_GNSS_TP1",
-            "TP-USE_LOCKED_TP1",
-            "TP-ALIGN_TO_TOW_TP1",
-            "TP-POL_TP1",
-            "TP-TIMEGRID_TP1",
-            "TP-PERIOD_TP2",
-            "TP-PERIOD_LOCK_TP2",
-            "TP-FREQ_TP2",
-            "TP-FREQ_LOCK_TP2",
-            "TP-LEN_TP2",
-            "TP-LEN_LOCK_TP2",
-            "TP-DUTY_TP2",
-            "TP-DUTY_LOCK_TP2",
-            "TP-USER_DELAY_TP2",
-            "TP-TP2_ENA",
-            "TP-SYNC_GNSS_TP2",
-            "TP-USE_LOCKED_TP2",
-            "TP-ALIGN_TO_TOW_TP2",
-            "TP-POL_TP2",
-            "TP-TIMEGRID_TP2",
-            "UART1-BAUDRATE",
-            "UART1-STOPBITS",
-            "UART1-DATABITS",
-            "UART1-PARITY",
-            "UART1-ENABLED",
-            "UART1INPROT-UBX",
-            "UART1INPROT-NMEA",
-            "UART1INPROT-RTCM2X",
-            "UART1INPROT-RTCM3X",
-            "UART1OUTPROT-UBX",
-            "UART1OUTPROT-NMEA",
-            "UART1OUTPROT-RTCM3X",
-            "UART2-BAUDRATE",
-            "UART2-STOPBITS",
-            "UART2-DATABITS",
-            "UART2-PARITY",
-            "UART2-ENABLED",
-            "UART2-REMAP",
-            "UART2INPROT-UBX",
-            "UART2INPROT-NMEA",
-            "UART2INPROT-RTCM2X",
-            "UART2INPROT-RTCM3X",
-            "UART2OUTPROT-UBX",
-            "UART2OUTPROT-NMEA",
-            "UART2OUTPROT-RTCM3X",
-            "USB-ENABLED",
-            "USB-SELFPOW",
-            "USB-VENDOR_ID",
-            "USB-PRODUCT_ID",
-            "USB-POWER",
-            "USB-VENDOR_STR0",
-            "USB-VENDOR_STR1",
-            "USB-VENDOR_STR2",
-            "USB-VENDOR_STR3",
-            "USB-PRODUCT_STR0",
-            "USB-PRODUCT_STR1",
-            "USB-PRODUCT_STR2",
-            "USB-PRODUCT_STR3",
-            "USB-SERIAL_NO_STR0",
-            "USB-SERIAL_NO_STR1",
-            "USB-SERIAL_NO_STR2",
-            "USB-SERIAL_NO_STR3",
-            "USBINPROT-UBX",
-            "USBINPROT-NMEA",
-            "USBINPROT-RTCM2X",
-            "USBINPROT-RTCM3X",
-            "USBOUTPROT-UBX",
-            "USBOUTPROT-NMEA",
-            "USBOUTPROT-RTCM3X",
-            ""};
-
-        static const unsigned long vid[] = {
-            0x20240011, 0x10240012, 0x20240013, 0x20240014, 0x10240020,
-            0x40240021, 0x40240022, 0x40240023, 0x10240030, 0x40240031,
-            0x40240032, 0x40240033, 0x10240040, 0x40240041, 0x40240042,
-            0x40240043, 0x10240050, 0x40240051, 0x40240052, 0x40240053,
-            0x10a3002e, 0x10a3002f, 0x10a30030, 0x10a30031, 0x10a30032,
-            0x10a30033, 0x10a30034, 0x10a30035, 0x20a30036, 0x20a30037,
-            0x20a30038, 0x20510001, 0x10510002, 0x10510003, 0x10710001,
-            0x10710002, 0x10710003, 0x10710004, 0x10720001, 0x10720002,
-            0x10720004, 0x20920001, 0x20920002, 0x20920003, 0x20920004,
-            0x20920005, 0x20920006, 0x20920007, 0x20920008, 0x20920009,
-            0x2092000a, 0x20410001, 0x20410002, 0x1041000d, 0x20410010,
-            0x10410013, 0x10de0002, 0x10de0003, 0x10de0004, 0x30de0005,
-            0x30de0006, 0x30de0007, 0x40de0008, 0x20250038, 0x3025003b,
-            0x209100a6, 0x209100aa, 0x209100a7, 0x209100a8, 0x209100a9,
-            0x209100dd, 0x209100e1, 0x209100de, 0x209100df, 0x209100e0,
-            0x209100ba, 0x209100be, 0x209100bb, 0x209100bc, 0x209100bd,
-            0x209100c9, 0x209100cd, 0x209100ca, 0x209100cb, 0x209100cc,
-            0x209100b5, 0x209100b9, 0x209100b6, 0x209100b7, 0x209100b8,
-            0x209100ce, 0x209100d2, 0x209100cf, 0x209100d0, 0x209100d1,
-            0x209100bf, 0x209100c3, 0x209100c0, 0x209100c1, 0x209100c2,
-            0x209100d3, 0x209100d7, 0x209100d4, 0x209100d5, 0x209100d6,
-            0x209100c4, 0x209100c8, 0x209100c5, 0x209100c6, 0x209100c7,
-            0x209100ab, 0x209100af, 0x209100ac, 0x209100ad, 0x209100ae,
-            0x209100e7, 0x209100eb, 0x209100e8, 0x209100e9, 0x209100ea,
-            0x209100b0, 0x209100b4, 0x209100b1, 0x209100b2, 0x209100b3,
-            0x209100d8, 0x209100dc, 0x209100d9, 0x209100da, 0x209100db,
-            0x209100ec, 0x209100f0, 0x209100ed, 0x209100ee, 0x209100ef,
-            0x209100f1, 0x209100f5, 0x209100f2, 0x209100f3, 0x209100f4,
-            0x209100f6, 0x209100fa, 0x209100f7, 0x209100f8, 0x209100f9,
-            0x209102bd, 0x209102c1, 0x209102be, 0x209102bf, 0x209102c0,
-            0x2091035e, 0x20910362, 0x2091035f, 0x20910360, 0x20910361,
-            0x209102cc, 0x209102d0, 0x209102cd, 0x209102ce, 0x209102cf,
-            0x209102d1, 0x20910367, 0x20910364, 0x20910365, 0x20910366,
-            0x209102d5, 0x209102d2, 0x209102d3, 0x209102d4, 0x20910368,
-            0x2091036c, 0x20910369, 0x2091036a, 0x2091036b, 0x20910318,
-            0x2091031c, 0x20910319, 0x2091031a, 0x2091031b, 0x2091036d,
-            0x20910371, 0x2091036e, 0x2091036f, 0x20910370, 0x209102d6,
-            0x209102da, 0x209102d7, 0x209102d8, 0x209102d9, 0x20910303,
-            0x20910307, 0x20910304, 0x20910305, 0x20910306, 0x209102fe,
-            0x20910302, 0x209102ff, 0x20910300, 0x20910301, 0x20910381,
-            0x20910385, 0x20910382, 0x20910383, 0x20910384, 0x20910259,
-            0x2091025d, 0x2091025a, 0x2091025b, 0x2091025c, 0x2091034f,
-            0x20910353, 0x20910350, 0x20910351, 0x20910352, 0x209101b9,
-            0x209101bd, 0x209101ba, 0x209101bb, 0x209101bc, 0x20910354,
-            0x20910358, 0x20910355, 0x20910356, 0x20910357, 0x209101b4,
-            0x209101b8, 0x209101b5, 0x209101b6, 0x209101b7, 0x209101a5,
-            0x209101a9, 0x209101a6, 0x209101a7, 0x209101a8, 0x20910196,
-            0x2091019a, 0x20910197, 0x20910198, 0x20910199, 0x20910359,
-            0x2091035d, 0x2091035a, 0x2091035b, 0x2091035c, 0x209101a0,
-            0x209101a4, 0x209101a1, 0x209101a2, 0x209101a3, 0x20910187,
-            0x2091018b, 0x20910188, 0x20910189, 0x2091018a, 0x2091019b,
-            0x2091019f, 0x2091019c, 0x2091019d, 0x2091019e, 0x2091019b,
-            0x2091019f, 0x2091019c, 0x2091019d, 0x2091019e, 0x20910065,
-            0x20910069, 0x20910066, 0x20910067, 0x20910068, 0x20910038,
-            0x2091003c, 0x20910039, 0x2091003a, 0x2091003b, 0x2091015f,
-            0x20910163, 0x20910160, 0x20910161, 0x20910162, 0x209100a1,
-            0x209100a5, 0x209100a2, 0x209100a3, 0x209100a4, 0x2091002e,
-            0x20910032, 0x2091002f, 0x20910030, 0x20910031, 0x20910033,
-            0x20910037, 0x20910034, 0x20910035, 0x20910036, 0x2091007e,
-            0x20910082, 0x2091007f, 0x20910080, 0x20910081, 0x20910010,
-            0x20910014, 0x20910011, 0x20910012, 0x20910013, 0x20910024,
-            0x20910028, 0x20910025, 0x20910026, 0x20910027, 0x20910029,
-            0x2091002d, 0x2091002a, 0x2091002b, 0x2091002c, 0x20910006,
-            0x2091000a, 0x20910007, 0x20910008, 0x20910009, 0x2091008d,
-            0x20910091, 0x2091008e, 0x2091008f, 0x20910090, 0x20910015,
-            0x20910019, 0x20910016, 0x20910017, 0x20910018, 0x2091006a,
-            0x2091006e, 0x2091006b, 0x2091006c, 0x2091006d, 0x20910345,
-            0x20910349, 0x20910346, 0x20910347, 0x20910348, 0x2091001a,
-            0x2091001e, 0x2091001b, 0x2091001c, 0x2091001d, 0x20910088,
-            0x2091008c, 0x20910089, 0x2091008a, 0x2091008b, 0x20910051,
-            0x20910055, 0x20910052, 0x20910053, 0x20910054, 0x20910056,
-            0x2091005a, 0x20910057, 0x20910058, 0x20910059, 0x2091004c,
-            0x20910050, 0x2091004d, 0x2091004e, 0x2091004f, 0x20910047,
-            0x2091004b, 0x20910048, 0x20910049, 0x2091004a, 0x20910060,
-            0x20910064, 0x20910061, 0x20910062, 0x20910063, 0x2091005b,
-            0x2091005f, 0x2091005c, 0x2091005d, 0x2091005e, 0x2091003d,
-            0x20910041, 0x2091003e, 0x2091003f, 0x20910040, 0x20910042,
-            0x20910046, 0x20910043, 0x20910044, 0x20910045, 0x20910204,
-            0x20910208, 0x20910205, 0x20910206, 0x20910207, 0x209102a4,
-            0x209102a8, 0x209102a5, 0x209102a6, 0x209102a7, 0x2091025e,
-            0x20910262, 0x2091025f, 0x20910260, 0x20910261, 0x20910268,
-            0x2091026c, 0x20910269, 0x2091026a, 0x2091026b, 0x20910231,
-            0x20910235, 0x20910232, 0x20910233, 0x20910234, 0x20910097,
-            0x2091009b, 0x20910098, 0x20910099, 0x2091009a, 0x20910178,
-            0x2091017c, 0x20910179, 0x2091017a, 0x2091017b, 0x2091017d,
-            0x20910181, 0x2091017e, 0x2091017f, 0x20910180, 0x20910092,
-            0x20910096, 0x20910093, 0x20910094, 0x20910095, 0x20140011,
-            0x20110011, 0x10110013, 0x30110017, 0x10110019, 0x2011001c,
-            0x20110021, 0x10110025, 0x10110061, 0x50110062, 0x50110063,
-            0x40110064, 0x40110065, 0x40110066, 0x40110067, 0x40110068,
-            0x40110069, 0x4011006a, 0x201100a1, 0x201100a2, 0x201100a3,
-            0x201100a4, 0x201100aa, 0x201100ab, 0x301100b1, 0x301100b2,
-            0x301100b3, 0x301100b4, 0x301100b5, 0x401100c1, 0x401100c2,
-            0x201100c4, 0x20930001, 0x20930002, 0x10930003, 0x10930004,
-            0x10930005, 0x10930006, 0x20930007, 0x10930011, 0x10930012,
-            0x10930015, 0x10930016, 0x10930017, 0x10930021, 0x10930022,
-            0x10930023, 0x10930024, 0x10930025, 0x10930026, 0x20930031,
-            0x20930032, 0x30930033, 0x10220001, 0x10220002, 0x10220003,
-            0x10220004, 0x20220005, 0x20220021, 0x20220022, 0x20220032,
-            0x20220031, 0x30210001, 0x30210002, 0x20210003, 0x10c70001,
-            0x10c70002, 0x20c70003, 0x50c70004, 0x50c70005, 0x50c70006,
-            0x50c70007, 0x10360002, 0x10360003, 0x10360004, 0x10360005,
-            0x50360006, 0x1031001f, 0x10310001, 0x10310003, 0x10310020,
-            0x10310005, 0x10310021, 0x10310007, 0x1031000a, 0x10310022,
-            0x1031000d, 0x1031000e, 0x10310024, 0x10310012, 0x10310014,
-            0x10310015, 0x10310025, 0x10310018, 0x1031001a, 0x20640001,
-            0x10640002, 0x10640003, 0x10640005, 0x10640006, 0x10790001,
-            0x10790002, 0x10790003, 0x10790004, 0x107a0001, 0x107a0002,
-            0x107a0004, 0x20030001, 0x20030002, 0x40030003, 0x40030004,
-            0x40030005, 0x20030006, 0x20030007, 0x20030008, 0x40030009,
-            0x4003000a, 0x4003000b, 0x2003000c, 0x2003000d, 0x2003000e,
-            0x4003000f, 0x40030010, 0x40030011, 0x20050023, 0x20050030,
-            0x30050001, 0x40050002, 0x40050003, 0x40050024, 0x40050025,
-            0x40050004, 0x40050005, 0x5005002a, 0x5005002b, 0x40050006,
-            0x10050007, 0x10050008, 0x10050009, 0x1005000a, 0x1005000b,
-            0x2005000c, 0x4005000d, 0x4005000e, 0x40050026, 0x40050027,
-            0x4005000f, 0x40050010, 0x5005002c, 0x5005002d, 0x40050011,
-            0x10050012, 0x10050013, 0x10050014, 0x10050015, 0x10050016,
-            0x20050017, 0x40520001, 0x20520002, 0x20520003, 0x20520004,
-            0x10520005, 0x10730001, 0x10730002, 0x10730003, 0x10730004,
-            0x10740001, 0x10740002, 0x10740004, 0x40530001, 0x20530002,
-            0x20530003, 0x20530004, 0x10530005, 0x10530006, 0x10750001,
-            0x10750002, 0x10750003, 0x10750004, 0x10760001, 0x10760002,
-            0x10760004, 0x10650001, 0x10650002, 0x3065000a, 0x3065000b,
-            0x3065000c, 0x5065000d, 0x5065000e, 0x5065000f, 0x50650010,
-            0x50650011, 0x50650012, 0x50650013, 0x50650014, 0x50650015,
-            0x50650016, 0x50650017, 0x50650018, 0x10770001, 0x10770002,
-            0x10770003, 0x10770004, 0x10780001, 0x10780002, 0x10780004};
-
-        static const int vprm[] = {
-            FU1, FU1, FU1, FU1, FU1, FI4, FI4, FU4, FU1, FI4,
-            FI4, FU4, FU1, FI4, FI4, FU4, FU1, FI4, FI4, FU4,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU2,
-            FU2, FU2, FU4, FU1, FU2, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU2, FU1, FU1,
-            FU1, FU1, FU1, FR8, FR8, FR4, FR4, FR4, FR4, FR4,
-            FR4, FR4, FU1, FU1, FU1, FI1, FU1, FU1, FU2, FU2,
-            FU2, FU2, FU2, FI4, FU4, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU2, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU2, FU2, FU1, FU1,
-            FU1, FU1, FU8, FU8, FU8, FU8, FU1, FU1, FU1, FU1,
-            FU8, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FI4, FI4, FI4, FI1, FI1, FI1, FI4,
-            FI4, FI4, FI1, FI1, FI1, FU4, FU4, FU4, FU1, FU1,
-            FI2, FU4, FU4, FU4, FU4, FU4, FU4, FR8, FR8, FI4,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU4, FU4, FU4, FU4,
-            FU4, FU4, FR8, FR8, FI4, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU4, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU4, FU1, FU1, FU1, FU1, FU1, FU1,
-            FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU1, FU2, FU2,
-            FU2, FU8, FU8, FU8, FU8, FU8, FU8, FU8, FU8, FU8,
-            FU8, FU8, FU8, FU1, FU1, FU1, FU1, FU1, FU1, FU1};
-
-        if (strncmp(args[j], "CFG-", 4))
-            return 0;
+        uint32_t key;
+        int type;
 
-        for (k = 0; *vcmd[k]; k++)
-        {
-            if (!strcmp(args[j] + 4, vcmd[k]))
-                break;
-        }
+        if (!valset_key_find(args[j], &key, &type))
+            return 0;
 
-        if (!*vcmd[k])
+        if (q - buff + 4 + field_len(type) + UBX_CHECKSUM_LEN > len)
             return 0;
 
-        setU4(q, (unsigned long)vid[k]);
+        setU4(q, key);
         q += 4;
 
         /* Set value */
-        switch (vprm[k])
+        switch (type)
         {
         case FU1:
-            setU1(q, (unsigned char)atoi(args[j + 1]));
+        case FI1:
+            setU1(q, (uint8_t)stoi64(args[j + 1]));
             q += 1;
             break;
         case FU2:
-            setU2(q, (unsigned short)atoi(args[j + 1]));
+        case FI2:
+            setU2(q, (uint16_t)stoi64(args[j + 1]));
             q += 2;
             break;
         case FU4:
-            setU4(q, (unsigned long)atoi(args[j + 1]));
+        case FI4:
+            setU4(q, (uint32_t)stoi64(args[j + 1]));
             q += 4;
             break;
-        /*
         case FU8:
-            setU8(q, (unsigned long long)atoi(args[j + 2]));
+            setU8(q, (uint64_t)stoi64(args[j + 1]));
             q += 8;
             break;
-        */
-        case FI1:
-            setI1(q, (signed char)atoi(args[j + 1]));
-            q += 1;
-            break;
-        case FI2:
-            setI2(q, (signed short)atoi(args[j + 1]));
-            q += 2;
-            break;
-        case FI4:
-            setI4(q, (signed long)atoi(args[j + 1]));
-            q += 4;
-            break;
         case FR4:
             setR4(q, (float)atof(args[j + 1]));
             q += 4;
@@ -1276,11 +1185,11 @@ uint32_t ubx_gen_cmd(const char *msg, uint8_t *buff)
             q += 8;
             break;
         case FS32:
-            sprintf((char *)q, "%-32.32s", args[j + 1]);
+            sprintf((char *)q, "%-32.*s", toklen32(args[j + 1]), args[j + 1]);
             q += 32;
             break;
         default:
-            setU1(q, (unsigned char)atoi(args[j + 1]));
+            setU1(q, (uint8_t)stoi64(args[j + 1]));
             q += 1;
             break;
         }
@@ -1292,6 +1201,359 @@ uint32_t ubx_gen_cmd(const char *msg, uint8_t *buff)
     return n;
 }
 
+/* generate ublox poll request -------------------------------------------------
+ * a poll request is a message with an empty payload
+ * return : length of binary message
+ *-----------------------------------------------------------------------------*/
+uint32_t ubx_gen_poll(uint8_t cls, uint8_t id, uint8_t *buff)
+{
+    int n = UBX_HEADER_LEN + UBX_CHECKSUM_LEN;
+
+    buff[0] = UBXSYNC1;
+    buff[1] = UBXSYNC2;
+    buff[2] = cls;
+    buff[3] = id;
+    setU2(buff + 4, 0);
+    set_checksum(buff, n);
+    return n;
+}
+
+/* build a binary CFG-VALSET ---------------------------------------------------
+ * q = ubx_valset_begin(buff, layer);
+ * q = ubx_valset_add(q, key, value); ...
+ * n = ubx_valset_end(buff, q);
+ * the value size of each key is in bits 28-30 of its id
+ *-----------------------------------------------------------------------------*/
+uint8_t *ubx_valset_begin(uint8_t *buff, uint8_t layer)
+{
+    uint8_t *q = buff;
+
+    *q++ = UBXSYNC1;
+    *q++ = UBXSYNC2;
+    *q++ = UBXCFG;
+    *q++ = 0x8a;
+    q += 2;
+    *q++ = 0; /* version */
+    *q++ = layer;
+    *q++ = 0;
+    *q++ = 0;
+    return q;
+}
+
+uint8_t *ubx_valset_add(uint8_t *q, uint32_t key, int64_t value)
+{
+    setU4(q, key);
+    q += 4;
+
+    switch ((key >> 28) & 0x07)
+    {
+    case 3:
+        setU2(q, (uint16_t)value);
+        return q + 2;
+    case 4:
+        setU4(q, (uint32_t)value);
+        return q + 4;
+    case 5:
+        setU8(q, (uint64_t)value);
+        return q + 8;
+    default:
+        setU1(q, (uint8_t)value);
+        return q + 1;
+    }
+}
+
+/* value in the unit of the HP key, which holds value % 100 in -99..99 and the
+ * standard key holds the rest, both with the sign of value */
+uint8_t *ubx_valset_add_hp(uint8_t *q, uint32_t key, uint32_t key_hp, int64_t value)
+{
+    q = ubx_valset_add(q, key, value / 100);
+    return ubx_valset_add(q, key_hp, value % 100);
+}
+
+uint32_t ubx_valset_end(uint8_t *buff, uint8_t *q)
+{
+    int n = (int)(q - buff) + 2;
+    setU2(buff + 4, (unsigned short)(n - 8));
+    set_checksum(buff, n);
+    return n;
+}
+
+/* parse a decimal string into an integer in units of 10^-decimals -----------
+ * e.g. "20.96000401", 9 -> 20960004010, without floating point; extra
+ * decimals are rounded half away from zero
+ * return : false if s is not [+-]digits[.digits] or does not fit
+ *-----------------------------------------------------------------------------*/
+bool ubx_parse_fixed(const char *s, int decimals, int64_t *value)
+{
+    bool negative = false, point = false, round = false;
+    int64_t v = 0;
+    int digits = 0, scale = 0;
+
+    if (*s == '-' || *s == '+')
+    {
+        negative = *s++ == '-';
+    }
+
+    for (; *s; s++)
+    {
+        if (*s == '.' && !point)
+        {
+            point = true;
+        }
+        else if (*s >= '0' && *s <= '9')
+        {
+            digits++;
+            if (point && scale >= decimals)
+            {
+                /* only the first extra decimal matters */
+                if (scale++ == decimals)
+                {
+                    round = *s >= '5';
+                }
+                continue;
+            }
+            if (v > (INT64_MAX - 9) / 10)
+            {
+                return false;
+            }
+            v = v * 10 + (*s - '0');
+            scale += point;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    if (digits == 0)
+    {
+        return false;
+    }
+
+    for (; scale < decimals; scale++)
+    {
+        if (v > INT64_MAX / 10)
+        {
+            return false;
+        }
+        v *= 10;
+    }
+
+    v += round;
+    *value = negative ? -v : v;
+    return true;
+}
+
+/* ublox binary stream parser --------------------------------------------------
+ * collect frames from a byte stream which can also carry NMEA or RTCM3 data
+ *-----------------------------------------------------------------------------*/
+
+// drop n bytes from the collected data, then align on the next sync char
+static void ubx_parser_skip(ubx_parser_t *parser, size_t n)
+{
+    uint8_t *p = NULL;
+    if (n < parser->len)
+    {
+        p = memchr(parser->frame + n, UBXSYNC1, parser->len - n);
+    }
+
+    size_t skip = p ? (size_t)(p - parser->frame) : parser->len;
+    parser->len -= skip;
+    memmove(parser->frame, parser->frame + skip, parser->len);
+    parser->frame_len = 0;
+}
+
+// emit every complete frame held in the collected data
+static size_t ubx_parser_process(ubx_parser_t *parser, ubx_frame_cb_t cb, void *ctx)
+{
+    size_t frames = 0;
+
+    while (parser->len >= UBX_HEADER_LEN)
+    {
+        if (parser->frame_len == 0)
+        {
+            size_t len = U2(parser->frame + 4);
+            if (parser->frame[1] != UBXSYNC2 || len > UBX_PAYLOAD_LEN_MAX)
+            {
+                ubx_parser_skip(parser, 1);
+                continue;
+            }
+            parser->frame_len = UBX_HEADER_LEN + len + UBX_CHECKSUM_LEN;
+        }
+
+        if (parser->len < parser->frame_len)
+        {
+            break;
+        }
+
+        if (check_checksum(parser->frame, parser->frame_len))
+        {
+            if (cb)
+            {
+                cb(parser->frame[2], parser->frame[3],
+                   parser->frame + UBX_HEADER_LEN, parser->frame_len - UBX_HEADER_LEN - UBX_CHECKSUM_LEN,
+                   ctx);
+            }
+            frames++;
+            ubx_parser_skip(parser, parser->frame_len);
+        }
+        else
+        {
+            // resync from the byte after this false sync char
+            parser->checksum_errors++;
+            ubx_parser_skip(parser, 1);
+        }
+    }
+
+    return frames;
+}
+
+void ubx_parser_init(ubx_parser_t *parser)
+{
+    memset(parser, 0, sizeof(ubx_parser_t));
+}
+
+// feed a chunk of the stream, return the number of emitted frames
+size_t ubx_parser_feed(ubx_parser_t *parser, const uint8_t *data, size_t len, ubx_frame_cb_t cb, void *ctx)
+{
+    size_t frames = 0;
+
+    while (len > 0)
+    {
+        // hunt for a sync char
+        if (parser->len == 0)
+        {
+            const uint8_t *p = memchr(data, UBXSYNC1, len);
+            size_t skip = p ? (size_t)(p - data) : len;
+            data += skip;
+            len -= skip;
+            if (len == 0)
+            {
+                break;
+            }
+        }
+
+        // only take what the current header or frame needs
+        size_t n = parser->frame_len == 0 ? UBX_HEADER_LEN - parser->len : parser->frame_len - parser->len;
+        if (n > len)
+        {
+            n = len;
+        }
+        memcpy(parser->frame + parser->len, data, n);
+        parser->len += n;
+        data += n;
+        len -= n;
+
+        frames += ubx_parser_process(parser, cb, ctx);
+    }
+
+    return frames;
+}
+
+/* decode ublox navigation messages --------------------------------------------
+ * args   : uint8_t *payload I  message payload, without header and checksum
+ *          size_t   len     I  payload length
+ * return : false if the payload length does not match the message
+ *-----------------------------------------------------------------------------*/
+bool ubx_decode_nav_pvt(const uint8_t *payload, size_t len, ubx_nav_pvt_t *pvt)
+{
+    uint8_t *p = (uint8_t *)payload;
+
+    if (len != UBX_NAV_PVT_LEN)
+    {
+        return false;
+    }
+
+    pvt->iTOW = U4(p);
+    pvt->year = U2(p + 4);
+    pvt->month = U1(p + 6);
+    pvt->day = U1(p + 7);
+    pvt->hour = U1(p + 8);
+    pvt->min = U1(p + 9);
+    pvt->sec = U1(p + 10);
+    pvt->valid = U1(p + 11);
+    pvt->tAcc = U4(p + 12);
+    pvt->nano = I4(p + 16);
+    pvt->fixType = U1(p + 20);
+    pvt->flags = U1(p + 21);
+    pvt->flags2 = U1(p + 22);
+    pvt->numSV = U1(p + 23);
+    pvt->lon = I4(p + 24);
+    pvt->lat = I4(p + 28);
+    pvt->height = I4(p + 32);
+    pvt->hMSL = I4(p + 36);
+    pvt->hAcc = U4(p + 40);
+    pvt->vAcc = U4(p + 44);
+    pvt->velN = I4(p + 48);
+    pvt->velE = I4(p + 52);
+    pvt->velD = I4(p + 56);
+    pvt->gSpeed = I4(p + 60);
+    pvt->headMot = I4(p + 64);
+    pvt->sAcc = U4(p + 68);
+    pvt->headAcc = U4(p + 72);
+    pvt->pDOP = U2(p + 76);
+    pvt->flags3 = U2(p + 78);
+    memcpy(pvt->reserved0, p + 80, 4);
+    pvt->headVeh = I4(p + 84);
+    pvt->magDec = I2(p + 88);
+    pvt->magAcc = U2(p + 90);
+    return true;
+}
+
+bool ubx_decode_nav_hpposllh(const uint8_t *payload, size_t len, ubx_nav_hpposllh_t *pos)
+{
+    uint8_t *p = (uint8_t *)payload;
+
+    if (len != UBX_NAV_HPPOSLLH_LEN)
+    {
+        return false;
+    }
+
+    pos->version = U1(p);
+    memcpy(pos->reserved0, p + 1, 2);
+    pos->flags = U1(p + 3);
+    pos->iTOW = U4(p + 4);
+    pos->lon = I4(p + 8);
+    pos->lat = I4(p + 12);
+    pos->height = I4(p + 16);
+    pos->hMSL = I4(p + 20);
+    pos->lonHp = I1(p + 24);
+    pos->latHp = I1(p + 25);
+    pos->heightHp = I1(p + 26);
+    pos->hMSLHp = I1(p + 27);
+    pos->hAcc = U4(p + 28);
+    pos->vAcc = U4(p + 32);
+    return true;
+}
+
+bool ubx_decode_nav_svin(const uint8_t *payload, size_t len, ubx_nav_svin_t *svin)
+{
+    uint8_t *p = (uint8_t *)payload;
+
+    if (len != UBX_NAV_SVIN_LEN)
+    {
+        return false;
+    }
+
+    svin->version = U1(p);
+    memcpy(svin->reserved0, p + 1, 3);
+    svin->iTOW = U4(p + 4);
+    svin->dur = U4(p + 8);
+    svin->meanX = I4(p + 12);
+    svin->meanY = I4(p + 16);
+    svin->meanZ = I4(p + 20);
+    svin->meanXHP = I1(p + 24);
+    svin->meanYHP = I1(p + 25);
+    svin->meanZHP = I1(p + 26);
+    svin->reserved1 = U1(p + 27);
+    svin->meanAcc = U4(p + 28);
+    svin->obs = U4(p + 32);
+    svin->valid = U1(p + 36);
+    svin->active = U1(p + 37);
+    memcpy(svin->reserved2, p + 38, 2);
+    return true;
+}
+
 // void print_compare(uint8_t *array, uint32_t n, char *msg)
 // {
 //     char *buffer = calloc(128, sizeof(char));
@@ -0,0 +1,49 @@
+/*
+ * This file is part of the ESP32-GNSS-Base-Station firmware, published
+ * at (https://github.com/vuquangtrong/esp32-gnss-base-station).
+ * Copyright (c) 2023 Vu Quang Trong.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// generated by scripts/gen_ubx_profiles.py from profiles/*.csv, do not edit
+
+#include "ubx_profiles.h"
+
+// profiles/default.csv
+const uint8_t UBX_PROFILE_DEFAULT[] = {
+    0xb5, 0x62, 0x06, 0x8a, 0x77, 0x00, 0x00, 0x01, 0x00, 0x00, 0xbb, 0x00, 0x91, 0x20, 0x01, 0xd4,
+    0x00, 0x91, 0x20, 0x01, 0xca, 0x00, 0x91, 0x20, 0x00, 0xc0, 0x00, 0x91, 0x20, 0x00, 0xc5, 0x00,
+    0x91, 0x20, 0x00, 0xac, 0x00, 0x91, 0x20, 0x00, 0xb1, 0x00, 0x91, 0x20, 0x00, 0x07, 0x00, 0x92,
+    0x20, 0x00, 0x07, 0x00, 0x91, 0x20, 0x01, 0x34, 0x00, 0x91, 0x20, 0x01, 0x89, 0x00, 0x91, 0x20,
+    0x01, 0x06, 0x00, 0x93, 0x10, 0x01, 0x04, 0x00, 0x73, 0x10, 0x00, 0x04, 0x00, 0x74, 0x10, 0x00,
+    0x02, 0x00, 0x76, 0x10, 0x00, 0x01, 0x00, 0x76, 0x10, 0x00, 0x04, 0x00, 0x76, 0x10, 0x00, 0xbf,
+    0x02, 0x91, 0x20, 0x01, 0x60, 0x03, 0x91, 0x20, 0x01, 0x65, 0x03, 0x91, 0x20, 0x01, 0x6a, 0x03,
+    0x91, 0x20, 0x01, 0x6f, 0x03, 0x91, 0x20, 0x01, 0x05, 0x03, 0x91, 0x20, 0x01, 0xa0, 0x59,
+};
+const size_t UBX_PROFILE_DEFAULT_LEN = sizeof(UBX_PROFILE_DEFAULT);
+
+// profiles/rover.csv
+const uint8_t UBX_PROFILE_ROVER[] = {
+    0xb5, 0x62, 0x06, 0x8a, 0x0e, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01, 0x00, 0x03, 0x20, 0x00, 0x04,
+    0x00, 0x76, 0x10, 0x00, 0x4d, 0x1b,
+};
+const size_t UBX_PROFILE_ROVER_LEN = sizeof(UBX_PROFILE_ROVER);
+
+// profiles/survey.csv
+const uint8_t UBX_PROFILE_SURVEY[] = {
+    0xb5, 0x62, 0x06, 0x8a, 0x1e, 0x00, 0x00, 0x01, 0x00, 0x00, 0x10, 0x00, 0x03, 0x40, 0x2c, 0x01,
+    0x00, 0x00, 0x11, 0x00, 0x03, 0x40, 0x88, 0x13, 0x00, 0x00, 0x01, 0x00, 0x03, 0x20, 0x01, 0x04,
+    0x00, 0x76, 0x10, 0x01, 0xce, 0x20,
+};
+const size_t UBX_PROFILE_SURVEY_LEN = sizeof(UBX_PROFILE_SURVEY);
@@ -0,0 +1,251 @@
+/*
+ * This file is part of the ESP32-GNSS-Base-Station firmware, published
+ * at (https://github.com/vuquangtrong/esp32-gnss-base-station).
+ * Copyright (c) 2023 Vu Quang Trong.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "util.h"
+#include "config.h"
+#include "uart.h"
+#include "fanout.h"
+#include "rtcm3.h"
+#include "udp_output.h"
+
+#define TARGET_MAX 8
+#define MULTICAST_TTL 1
+#define EPOCH_GAP_MS 100
+#define DATAGRAM_LEN_MAX 1472 // Ethernet MTU without IP and UDP headers
+
+/*
+ * datagram header, followed by whole RTCM3 frames
+ * sequence is incremented on each datagram, so that receivers can detect lost datagrams
+ */
+#define HEADER_MAGIC 0xD5
+#define HEADER_VERSION 1
+#define HEADER_FLAG_EPOCH 0x01
+#define HEADER_LEN 8
+
+typedef struct __attribute__((packed))
+{
+    uint8_t magic;
+    uint8_t version;
+    uint8_t flags;
+    uint8_t frames;
+    uint32_t sequence; // big endian
+} udp_output_header_t;
+
+typedef struct
+{
+    struct sockaddr_in addr;
+    uint32_t datagrams;
+    uint32_t errors;
+} udp_output_target_t;
+
+static const char *TAG = "UDP_OUTPUT";
+
+static udp_output_target_t targets[TARGET_MAX];
+static size_t target_count = 0;
+static int udp_socket = -1;
+static bool epoch_mode = false;
+static TaskHandle_t udp_output_task_handle = NULL;
+
+static uint8_t datagram[DATAGRAM_LEN_MAX];
+static size_t datagram_len = HEADER_LEN;
+static uint8_t datagram_frames = 0;
+static uint32_t sequence = 0;
+static uint32_t overruns = 0;
+
+// parse "ip:port ip:port ...", multicast groups and unicast addresses can be mixed
+static void udp_output_targets_load(const char *s)
+{
+    char addr[16];
+    unsigned int port;
+    int n;
+
+    target_count = 0;
+    while (target_count < TARGET_MAX && sscanf(s, " %15[0-9.]:%u%n", addr, &port, &n) == 2)
+    {
+        s += n;
+        udp_output_target_t *target = &targets[target_count];
+        memset(target, 0, sizeof(udp_output_target_t));
+        target->addr.sin_family = AF_INET;
+        target->addr.sin_port = htons(port);
+        if (port == 0 || port > UINT16_MAX || inet_aton(addr, &target->addr.sin_addr) == 0)
+        {
+            ESP_LOGW(TAG, "Invalid target %s:%u", addr, port);
+            continue;
+        }
+        ESP_LOGI(TAG, "target %s:%u", addr, port);
+        target_count++;
+    }
+}
+
+static void udp_output_notify(void *arg)
+{
+    xTaskNotifyGive(udp_output_task_handle);
+}
+
+static void udp_output_flush()
+{
+    if (datagram_frames == 0)
+    {
+        return;
+    }
+
+    udp_output_header_t *header = (udp_output_header_t *)datagram;
+    header->magic = HEADER_MAGIC;
+    header->version = HEADER_VERSION;
+    header->flags = epoch_mode ? HEADER_FLAG_EPOCH : 0;
+    header->frames = datagram_frames;
+    header->sequence = htonl(sequence++);
+
+    for (size_t i = 0; i < target_count; i++)
+    {
+        if (sendto(udp_socket, datagram, datagram_len, MSG_DONTWAIT,
+                   (struct sockaddr *)&targets[i].addr, sizeof(targets[i].addr)) < 0)
+        {
+            targets[i].errors++;
+        }
+        else
+        {
+            targets[i].datagrams++;
+        }
+    }
+
+    datagram_len = HEADER_LEN;
+    datagram_frames = 0;
+}
+
+// append the frames written since pos, return the new position
+static uint32_t udp_output_read(fanout_t *fanout, uint32_t pos)
+{
+    uint8_t *frame;
+    uint32_t head = fanout_head(fanout);
+
+    while (pos != head)
+    {
+        if (fanout_overrun(fanout, pos))
+        {
+            overruns++;
+            return head;
+        }
+
+        uint8_t header[RTCM3_HEADER_LEN];
+        fanout_copy(fanout, pos, header, RTCM3_HEADER_LEN);
+        size_t len = rtcm3_frame_len(header);
+
+        if (datagram_len + len > DATAGRAM_LEN_MAX)
+        {
+            udp_output_flush();
+        }
+
+        frame = datagram + datagram_len;
+        fanout_copy(fanout, pos, frame, len);
+        if (fanout_overrun(fanout, pos))
+        {
+            overruns++;
+            return fanout_head(fanout);
+        }
+        pos += len;
+        datagram_len += len;
+        datagram_frames++;
+
+        // one datagram per frame, or per epoch which ends at the last MSM
+        if (!epoch_mode || (rtcm3_msm(rtcm3_msg_type(frame)) && !rtcm3_msm_multiple(frame)))
+        {
+            udp_output_flush();
+        }
+    }
+
+    return pos;
+}
+
+static void udp_output_task(void *args)
+{
+    fanout_t *fanout = uart_rtcm3_fanout();
+    uint32_t pos = fanout_head(fanout);
+
+    while (true)
+    {
+        // frames of an epoch come in a burst, send what is left when the burst ends
+        TickType_t timeout = datagram_frames ? pdMS_TO_TICKS(EPOCH_GAP_MS) : portMAX_DELAY;
+        if (ulTaskNotifyTake(pdTRUE, timeout) == 0)
+        {
+            udp_output_flush();
+            continue;
+        }
+
+        pos = udp_output_read(fanout, pos);
+    }
+}
+
+esp_err_t udp_output_init()
+{
+    udp_output_targets_load(config_get(CONFIG_UDP_TARGETS));
+    if (target_count == 0)
+    {
+        return ESP_OK;
+    }
+
+    epoch_mode = strcmp(config_get(CONFIG_UDP_MODE), "epoch") == 0;
+
+    udp_socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    ERROR_IF(udp_socket < 0,
+             return ESP_FAIL,
+             "Cannot create socket");
+
+    uint8_t ttl = MULTICAST_TTL;
+    setsockopt(udp_socket, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+
+    ERROR_IF(xTaskCreate(udp_output_task, "udp_output_task", 4096, NULL, 10, &udp_output_task_handle) != pdPASS,
+             return ESP_ERR_NO_MEM,
+             "Cannot create udp_output task");
+    ERROR_IF(!fanout_subscribe(uart_rtcm3_fanout(), udp_output_notify, NULL),
+             return ESP_FAIL,
+             "Cannot subscribe to RTCM3 output");
+
+    return ESP_OK;
+}
+
+// one line per target: address port datagrams errors, then the sequence and overrun counters
+size_t udp_output_info(char *buffer, size_t len)
+{
+    size_t n = 0;
+
+    for (size_t i = 0; i < target_count && n < len; i++)
+    {
+        n += snprintf(buffer + n, len - n, "%s %u %" PRIu32 " %" PRIu32 "\n",
+                      inet_ntoa(targets[i].addr.sin_addr),
+                      ntohs(targets[i].addr.sin_port),
+                      targets[i].datagrams,
+                      targets[i].errors);
+    }
+    if (n < len)
+    {
+        n += snprintf(buffer + n, len - n, "sequence %" PRIu32 " overruns %" PRIu32 "\n", sequence, overruns);
+    }
+
+    return MIN(n, len);
+}
@@ -29,6 +29,8 @@
 #include "wifi.h"
 #include "uart.h"
 #include "ntrip_client.h"
+#include "ntrip_caster.h"
+#include "udp_output.h"
 #include "web_app.h"
 
 #define WWW_PATH_BASE "/www"
@@ -95,6 +97,42 @@ static esp_err_t config_get_handler(httpd_req_t *req)
         return httpd_resp_sendstr_chunk(req, NULL);
     }
 
+    if (strcmp(query, "ntrip_cas_clients") == 0)
+    {
+        char *clients_info = calloc(REQ_BUFFER_SIZE * 4, sizeof(char));
+        ntrip_caster_clients_info(clients_info, REQ_BUFFER_SIZE * 4);
+        err = httpd_resp_sendstr_chunk(req, clients_info);
+        free(clients_info);
+        return httpd_resp_sendstr_chunk(req, NULL);
+    }
+
+    if (strcmp(query, "ntrip_cas_mounts") == 0)
+    {
+        char *mounts_info = calloc(REQ_BUFFER_SIZE * 2, sizeof(char));
+        ntrip_caster_mounts_info(mounts_info, REQ_BUFFER_SIZE * 2);
+        err = httpd_resp_sendstr_chunk(req, mounts_info);
+        free(mounts_info);
+        return httpd_resp_sendstr_chunk(req, NULL);
+    }
+
+    if (strcmp(query, "ntrip_cas_latency") == 0)
+    {
+        char *latency_info = calloc(REQ_BUFFER_SIZE * 2, sizeof(char));
+        ntrip_caster_latency_info(latency_info, REQ_BUFFER_SIZE * 2);
+        err = httpd_resp_sendstr_chunk(req, latency_info);
+        free(latency_info);
+        return httpd_resp_sendstr_chunk(req, NULL);
+    }
+
+    if (strcmp(query, "udp_out") == 0)
+    {
+        char *udp_info = calloc(REQ_BUFFER_SIZE, sizeof(char));
+        udp_output_info(udp_info, REQ_BUFFER_SIZE);
+        err = httpd_resp_sendstr_chunk(req, udp_info);
+        free(udp_info);
+        return httpd_resp_sendstr_chunk(req, NULL);
+    }
+
     // send each status as a chunk
     for (uint8_t type = CONFIG_START; type < CONFIG_MAX; type++)
     {
@@ -186,6 +224,10 @@ static esp_err_t action_post_handler(httpd_req_t *req)
 
         ubx_set_mode_fixed(args[1], args[2], args[3]);
     }
+    else if (strcmp(args[0], "gnss_mode_set_fixed_ecef") == 0 && narg > 3)
+    {
+        ubx_set_mode_fixed_xyz(args[1], args[2], args[3]);
+    }
     else if (strcmp(args[0], "wifi_connect") == 0)
     {
         // save wifi ssid and pwd
@@ -202,11 +244,21 @@ static esp_err_t action_post_handler(httpd_req_t *req)
     }
     else if (strcmp(args[0], "system_save") == 0)
     {
-        for (size_t type = CONFIG_NVS_START; type < CONFIG_MAX; type++)
+        // the settings page only sends configs up to the base position
+        for (size_t type = CONFIG_NVS_START; type <= CONFIG_BASE_ALT; type++)
         {
             config_set(type, args[type + 1]);
         }
     }
+    else if (strcmp(args[0], "config_set") == 0)
+    {
+        // set a config by its name, e.g. cas_policy
+        config_t type = narg > 2 ? config_find(args[1]) : CONFIG_MAX;
+        if (type >= CONFIG_NVS_START && type < CONFIG_MAX)
+        {
+            config_set(type, args[2]);
+        }
+    }
     else if (strcmp(args[0], "system_restart") == 0)
     {
         esp_restart();
@@ -0,0 +1,333 @@
+/*
+ * This file is part of the ESP32-GNSS-Base-Station firmware, published
+ * at (https://github.com/vuquangtrong/esp32-gnss-base-station).
+ * Copyright (c) 2023 Vu Quang Trong.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "fanout.h"
+
+/*
+ * host benchmark of the RTCM3 path from the UART task to its consumers:
+ * - ring: the producer writes each frame once in the fan-out ring,
+ *   every consumer reads it in place from its own position
+ * - event: the old esp_event_post path, each frame is copied in a new event,
+ *   queued, then the loop task calls every handler with it and frees it
+ * both paths give each consumer the same sink, a copy to a send buffer
+ *
+ *   build/bench_fanout [consumers] [megabytes]
+ */
+
+#ifndef RING_SIZE
+#define RING_SIZE (16 * 1024)
+#endif
+#define EVENT_QUEUE_LEN 32 // CONFIG_ESP_SYSTEM_EVENT_QUEUE_SIZE
+#define SINK_LEN 2048
+
+static const size_t FRAME_LENS[] = {25, 188, 406, 622, 230, 1029, 301, 87};
+#define FRAME_KINDS (sizeof(FRAME_LENS) / sizeof(FRAME_LENS[0]))
+
+static uint8_t frames[FRAME_KINDS][1029];
+static size_t consumers = FANOUT_SUBSCRIBER_MAX;
+static size_t total_len = 64 * 1024 * 1024;
+
+typedef struct sink_t
+{
+    uint8_t buffer[SINK_LEN];
+    size_t len;
+    uint64_t bytes;
+} sink_t;
+
+static sink_t sinks[FANOUT_SUBSCRIBER_MAX];
+
+static void sink_write(sink_t *sink, const uint8_t *data, size_t len)
+{
+    while (len > 0)
+    {
+        size_t n = SINK_LEN - sink->len < len ? SINK_LEN - sink->len : len;
+        memcpy(sink->buffer + sink->len, data, n);
+        sink->len = (sink->len + n) % SINK_LEN;
+        sink->bytes += n;
+        data += n;
+        len -= n;
+    }
+}
+
+static double now_s(clockid_t clock)
+{
+    struct timespec t;
+    clock_gettime(clock, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+/* ring path */
+
+typedef struct ring_consumer_t
+{
+    fanout_t *fanout;
+    sem_t data;
+    atomic_bool waiting; // like the eventfd of the caster, only a sleeping consumer is woken up
+    _Atomic uint32_t pos;
+    sink_t *sink;
+} ring_consumer_t;
+
+static ring_consumer_t ring_consumers[FANOUT_SUBSCRIBER_MAX];
+static sem_t ring_space;
+static atomic_bool ring_full;
+static atomic_bool ring_done;
+static atomic_uint ring_overruns;
+
+static void ring_notify(void *arg)
+{
+    ring_consumer_t *consumer = arg;
+    if (atomic_exchange(&consumer->waiting, false))
+    {
+        sem_post(&consumer->data);
+    }
+}
+
+static void *ring_consumer_task(void *arg)
+{
+    ring_consumer_t *consumer = arg;
+    uint32_t pos = 0;
+
+    while (true)
+    {
+        const uint8_t *data;
+        size_t len = fanout_peek(consumer->fanout, pos, &data);
+        if (len == 0)
+        {
+            if (atomic_load(&ring_done) && pos == fanout_head(consumer->fanout))
+            {
+                break;
+            }
+            atomic_store(&consumer->waiting, true);
+            if (pos == fanout_head(consumer->fanout) && !atomic_load(&ring_done))
+            {
+                sem_wait(&consumer->data);
+            }
+            continue;
+        }
+
+        sink_write(consumer->sink, data, len);
+        if (fanout_overrun(consumer->fanout, pos))
+        {
+            atomic_fetch_add(&ring_overruns, 1);
+        }
+        pos += len;
+        atomic_store(&consumer->pos, pos);
+        if (atomic_exchange(&ring_full, false))
+        {
+            sem_post(&ring_space);
+        }
+    }
+    return NULL;
+}
+
+static void ring_run(void)
+{
+    fanout_t *fanout = fanout_create(RING_SIZE);
+    pthread_t threads[FANOUT_SUBSCRIBER_MAX];
+
+    sem_init(&ring_space, 0, 0);
+    for (size_t i = 0; i < consumers; i++)
+    {
+        ring_consumer_t *consumer = &ring_consumers[i];
+        consumer->fanout = fanout;
+        consumer->sink = &sinks[i];
+        sem_init(&consumer->data, 0, 0);
+        fanout_subscribe(fanout, ring_notify, consumer);
+        pthread_create(&threads[i], NULL, ring_consumer_task, consumer);
+    }
+
+    for (size_t written = 0, i = 0; written < total_len; i++)
+    {
+        size_t len = FRAME_LENS[i % FRAME_KINDS];
+
+        // the UART is the pace on target, here wait for the slowest consumer
+        for (size_t c = 0; c < consumers; c++)
+        {
+            while (fanout_head(fanout) + len - atomic_load(&ring_consumers[c].pos) > RING_SIZE)
+            {
+                atomic_store(&ring_full, true);
+                if (fanout_head(fanout) + len - atomic_load(&ring_consumers[c].pos) > RING_SIZE)
+                {
+                    sem_wait(&ring_space);
+                }
+            }
+        }
+
+        fanout_write(fanout, frames[i % FRAME_KINDS], len);
+        written += len;
+    }
+
+    atomic_store(&ring_done, true);
+    for (size_t i = 0; i < consumers; i++)
+    {
+        ring_notify(&ring_consumers[i]);
+        pthread_join(threads[i], NULL);
+    }
+}
+
+/* event path */
+
+typedef struct event_t
+{
+    size_t len;
+    uint8_t data[];
+} event_t;
+
+static event_t *event_queue[EVENT_QUEUE_LEN];
+static size_t event_head;
+static size_t event_tail;
+static pthread_mutex_t event_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t event_not_empty = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t event_not_full = PTHREAD_COND_INITIALIZER;
+
+// esp_event_post copies the data in a new event and blocks while the queue is full
+static void event_post(const uint8_t *data, size_t len)
+{
+    event_t *event = malloc(sizeof(event_t) + len);
+    event->len = len;
+    memcpy(event->data, data, len);
+
+    pthread_mutex_lock(&event_lock);
+    while (event_tail - event_head == EVENT_QUEUE_LEN)
+    {
+        pthread_cond_wait(&event_not_full, &event_lock);
+    }
+    event_queue[event_tail++ % EVENT_QUEUE_LEN] = event;
+    pthread_cond_signal(&event_not_empty);
+    pthread_mutex_unlock(&event_lock);
+}
+
+// the loop task calls every handler in turn, then frees the event
+static void *event_loop_task(void *arg)
+{
+    (void)arg;
+
+    while (true)
+    {
+        pthread_mutex_lock(&event_lock);
+        while (event_tail == event_head)
+        {
+            pthread_cond_wait(&event_not_empty, &event_lock);
+        }
+        event_t *event = event_queue[event_head++ % EVENT_QUEUE_LEN];
+        pthread_cond_signal(&event_not_full);
+        pthread_mutex_unlock(&event_lock);
+
+        if (event == NULL)
+        {
+            break;
+        }
+        for (size_t i = 0; i < consumers; i++)
+        {
+            sink_write(&sinks[i], event->data, event->len);
+        }
+        free(event);
+    }
+    return NULL;
+}
+
+static void event_run(void)
+{
+    pthread_t thread;
+    pthread_create(&thread, NULL, event_loop_task, NULL);
+
+    for (size_t written = 0, i = 0; written < total_len; i++)
+    {
+        size_t len = FRAME_LENS[i % FRAME_KINDS];
+        event_post(frames[i % FRAME_KINDS], len);
+        written += len;
+    }
+
+    pthread_mutex_lock(&event_lock);
+    while (event_tail - event_head == EVENT_QUEUE_LEN)
+    {
+        pthread_cond_wait(&event_not_full, &event_lock);
+    }
+    event_queue[event_tail++ % EVENT_QUEUE_LEN] = NULL;
+    pthread_cond_signal(&event_not_empty);
+    pthread_mutex_unlock(&event_lock);
+    pthread_join(thread, NULL);
+}
+
+static void bench(const char *name, void (*run)(void))
+{
+    memset(sinks, 0, sizeof(sinks));
+
+    double wall = now_s(CLOCK_MONOTONIC);
+    double cpu = now_s(CLOCK_PROCESS_CPUTIME_ID);
+    run();
+    wall = now_s(CLOCK_MONOTONIC) - wall;
+    cpu = now_s(CLOCK_PROCESS_CPUTIME_ID) - cpu;
+
+    uint64_t delivered = 0;
+    for (size_t i = 0; i < consumers; i++)
+    {
+        delivered += sinks[i].bytes;
+    }
+
+    // per produced byte, every consumer gets a copy of it
+    uint64_t produced = delivered / consumers;
+    printf("%-6s %10.1f %12.1f %10.2f %10.2f\n", name,
+           produced / wall / 1e6, delivered / wall / 1e6,
+           cpu * 1e9 / produced, cpu * 1e9 / delivered);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        consumers = strtoul(argv[1], NULL, 10);
+        if (consumers == 0 || consumers > FANOUT_SUBSCRIBER_MAX)
+        {
+            printf("consumers: 1 to %d\n", FANOUT_SUBSCRIBER_MAX);
+            return 1;
+        }
+    }
+    if (argc > 2)
+    {
+        total_len = strtoul(argv[2], NULL, 10) * 1024 * 1024;
+    }
+
+    for (size_t i = 0; i < FRAME_KINDS; i++)
+    {
+        for (size_t j = 0; j < FRAME_LENS[i]; j++)
+        {
+            frames[i][j] = rand();
+        }
+    }
+
+    printf("%zu consumers, %zu MB\n", consumers, total_len / 1024 / 1024);
+    printf("path         MB/s  MB/s_total  ns/byte  ns/byte_total\n");
+    bench("ring", ring_run);
+    bench("event", event_run);
+
+    if (atomic_load(&ring_overruns))
+    {
+        printf("ring overruns: %u\n", atomic_load(&ring_overruns));
+        return 1;
+    }
+    return 0;
+}
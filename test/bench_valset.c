@@ -0,0 +1,111 @@
+/*
+ * This file is part of the ESP32-GNSS-Base-Station firmware, published
+ * at (https://github.com/vuquangtrong/esp32-gnss-base-station).
+ * Copyright (c) 2023 Vu Quang Trong.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <time.h>
+
+#include "../src/ublox.c"
+
+/*
+ * host benchmark of the VALSET key lookup: binary search in the sorted table
+ * against the linear scan of the names which was used before
+ *
+ *   build/bench_valset [rounds]
+ */
+
+#define NAME_LEN 64
+
+static char names[VALSET_KEYS_LEN + 1][NAME_LEN];
+
+static bool valset_key_scan(const char *tok, uint32_t *key, int *type)
+{
+    if (strncmp(tok, "CFG-", 4))
+        return false;
+
+    for (size_t i = 0; i < VALSET_KEYS_LEN; i++)
+    {
+        if (!tokcmp(tok + 4, VALSET_KEYS[i].name))
+        {
+            *key = VALSET_KEYS[i].id;
+            *type = VALSET_KEYS[i].type;
+            return true;
+        }
+    }
+    return false;
+}
+
+static double now_ns(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+// all names once per round, and a name which is not in the table
+static double bench(bool (*find)(const char *, uint32_t *, int *), size_t rounds, uint32_t *sum)
+{
+    uint32_t key;
+    int type;
+
+    double start = now_ns();
+    for (size_t r = 0; r < rounds; r++)
+    {
+        for (size_t i = 0; i <= VALSET_KEYS_LEN; i++)
+        {
+            if (find(names[i], &key, &type))
+            {
+                *sum += key + type;
+            }
+        }
+    }
+    return (now_ns() - start) / (rounds * (VALSET_KEYS_LEN + 1));
+}
+
+int main(int argc, char **argv)
+{
+    size_t rounds = argc > 1 ? strtoul(argv[1], NULL, 10) : 2000;
+
+    for (size_t i = 0; i < VALSET_KEYS_LEN; i++)
+    {
+        snprintf(names[i], NAME_LEN, "CFG-%s", VALSET_KEYS[i].name);
+    }
+    snprintf(names[VALSET_KEYS_LEN], NAME_LEN, "CFG-USBOUTPROT-NONE");
+
+    // both lookups must agree, and the table must be sorted for bsearch
+    for (size_t i = 0; i <= VALSET_KEYS_LEN; i++)
+    {
+        uint32_t key1 = 0, key2 = 0;
+        int type1 = 0, type2 = 0;
+        bool found1 = valset_key_find(names[i], &key1, &type1);
+        bool found2 = valset_key_scan(names[i], &key2, &type2);
+        if (found1 != found2 || key1 != key2 || type1 != type2 || found1 != (i < VALSET_KEYS_LEN) ||
+            (i > 0 && i < VALSET_KEYS_LEN && strcmp(VALSET_KEYS[i - 1].name, VALSET_KEYS[i].name) >= 0))
+        {
+            printf("lookup mismatch: %s\n", names[i]);
+            return 1;
+        }
+    }
+
+    uint32_t sum1 = 0, sum2 = 0;
+    double search_ns = bench(valset_key_find, rounds, &sum1);
+    double scan_ns = bench(valset_key_scan, rounds / 10 + 1, &sum2);
+
+    printf("%zu keys\n", VALSET_KEYS_LEN);
+    printf("bsearch %8.1f ns/lookup\n", search_ns);
+    printf("scan    %8.1f ns/lookup\n", scan_ns);
+    return sum1 == 0 || sum2 == 0;
+}
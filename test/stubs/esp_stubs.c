@@ -0,0 +1,199 @@
+/*
+ * This file is part of the ESP32-GNSS-Base-Station firmware, published
+ * at (https://github.com/vuquangtrong/esp32-gnss-base-station).
+ * Copyright (c) 2023 Vu Quang Trong.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <esp_http_server.h>
+#include <esp_timer.h>
+#include <esp_vfs_eventfd.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <mbedtls/base64.h>
+
+// host stand-ins for the ESP-IDF functions called by the host tested sources
+
+int64_t esp_timer_get_time(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+esp_err_t esp_vfs_eventfd_register(const esp_vfs_eventfd_config_t *config)
+{
+    return ESP_OK;
+}
+
+typedef struct task_start_t
+{
+    TaskFunction_t task;
+    void *arg;
+} task_start_t;
+
+static void *task_thread(void *arg)
+{
+    task_start_t start = *(task_start_t *)arg;
+    free(arg);
+    start.task(start.arg);
+    return NULL;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t task, const char *name, uint32_t stack, void *arg, UBaseType_t priority, TaskHandle_t *handle)
+{
+    pthread_t thread;
+    task_start_t *start = malloc(sizeof(task_start_t));
+    start->task = task;
+    start->arg = arg;
+    if (pthread_create(&thread, NULL, task_thread, start) != 0)
+    {
+        free(start);
+        return pdFAIL;
+    }
+    pthread_detach(thread);
+    if (handle)
+    {
+        *handle = NULL;
+    }
+    return pdPASS;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    usleep(ticks * 1000);
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    pthread_exit(NULL);
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return esp_timer_get_time() / 1000;
+}
+
+// httpd is not running, the tests call the handlers themselves,
+// a session is closed at once through the close function given to httpd_start
+
+static httpd_close_func_t httpd_close_fn = NULL;
+
+esp_err_t httpd_start(httpd_handle_t *handle, const httpd_config_t *config)
+{
+    *handle = NULL;
+    httpd_close_fn = config->close_fn;
+    return ESP_OK;
+}
+
+esp_err_t httpd_register_uri_handler(httpd_handle_t handle, const httpd_uri_t *uri_handler)
+{
+    return ESP_OK;
+}
+
+esp_err_t httpd_register_err_handler(httpd_handle_t handle, httpd_err_code_t error, httpd_err_handler_func_t handler)
+{
+    return ESP_OK;
+}
+
+bool httpd_uri_match_wildcard(const char *reference_uri, const char *uri_to_match, size_t match_upto)
+{
+    return false;
+}
+
+int httpd_req_to_sockfd(httpd_req_t *req)
+{
+    return req->sockfd;
+}
+
+esp_err_t httpd_req_get_hdr_value_str(httpd_req_t *req, const char *field, char *value, size_t len)
+{
+    size_t field_len = strlen(field);
+    for (const char *line = req->headers; line && *line; line = strstr(line, "\r\n") + 2)
+    {
+        if (strncasecmp(line, field, field_len) == 0 && line[field_len] == ':')
+        {
+            const char *start = line + field_len + 1 + strspn(line + field_len + 1, " ");
+            size_t n = strcspn(start, "\r\n");
+            if (n >= len)
+            {
+                return ESP_ERR_INVALID_SIZE;
+            }
+            memcpy(value, start, n);
+            value[n] = '\0';
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t httpd_req_get_url_query_str(httpd_req_t *req, char *buf, size_t len)
+{
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t httpd_query_key_value(const char *query, const char *key, char *value, size_t len)
+{
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t httpd_resp_send_err(httpd_req_t *req, httpd_err_code_t error, const char *message)
+{
+    return ESP_OK;
+}
+
+int httpd_socket_send(httpd_handle_t handle, int sockfd, const char *buf, size_t len, int flags)
+{
+    return write(sockfd, buf, len);
+}
+
+esp_err_t httpd_sess_trigger_close(httpd_handle_t handle, int sockfd)
+{
+    if (httpd_close_fn == NULL)
+    {
+        return ESP_FAIL;
+    }
+    httpd_close_fn(handle, sockfd);
+    return ESP_OK;
+}
+
+int mbedtls_base64_encode(unsigned char *dst, size_t dlen, size_t *olen, const unsigned char *src, size_t slen)
+{
+    static const char TABLE[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    *olen = (slen + 2) / 3 * 4;
+    if (dlen < *olen + 1)
+    {
+        return -1;
+    }
+
+    unsigned char *p = dst;
+    for (size_t i = 0; i < slen; i += 3)
+    {
+        uint32_t n = src[i] << 16 | (i + 1 < slen ? src[i + 1] << 8 : 0) | (i + 2 < slen ? src[i + 2] : 0);
+        *p++ = TABLE[(n >> 18) & 0x3F];
+        *p++ = TABLE[(n >> 12) & 0x3F];
+        *p++ = i + 1 < slen ? TABLE[(n >> 6) & 0x3F] : '=';
+        *p++ = i + 2 < slen ? TABLE[n & 0x3F] : '=';
+    }
+    *p = '\0';
+    return 0;
+}
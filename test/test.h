@@ -0,0 +1,48 @@
+/*
+ * This file is part of the ESP32-GNSS-Base-Station firmware, published
+ * at (https://github.com/vuquangtrong/esp32-gnss-base-station).
+ * Copyright (c) 2023 Vu Quang Trong.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ESP32_GNSS_TEST_H
+#define ESP32_GNSS_TEST_H
+
+#include <stdio.h>
+
+// host test helpers, a failed check is reported and counted, the test goes on
+
+static int test_failures = 0;
+
+#define CHECK(cond)                                                          \
+    do                                                                       \
+    {                                                                        \
+        if (!(cond))                                                         \
+        {                                                                    \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);  \
+            test_failures++;                                                 \
+        }                                                                    \
+    } while (0)
+
+#define TEST_RUN(test)                                                       \
+    do                                                                       \
+    {                                                                        \
+        int before = test_failures;                                          \
+        test();                                                              \
+        printf("%s %s\n", test_failures == before ? "PASS" : "FAIL", #test); \
+    } while (0)
+
+#define TEST_EXIT() (test_failures ? 1 : 0)
+
+#endif // ESP32_GNSS_TEST_H
@@ -0,0 +1,418 @@
+/*
+ * This file is part of the ESP32-GNSS-Base-Station firmware, published
+ * at (https://github.com/vuquangtrong/esp32-gnss-base-station).
+ * Copyright (c) 2023 Vu Quang Trong.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <poll.h>
+#include <sched.h>
+#include <signal.h>
+
+#include "../src/ntrip_caster.c"
+#include "test.h"
+
+/*
+ * host test of the client slots, FREE -> CLAIMED -> ACTIVE -> FREE, under load:
+ * the real caster task broadcasts RTCM3 frames written at 10 Hz, while an httpd thread
+ * opens connections through the real stream handler and rovers read a while then hang up,
+ * socket numbers are reused at once, so a send to a freed slot would land in another stream,
+ * then several threads fight for the slots with claim() only
+ */
+
+#define CONNECTIONS 400
+#define CONNECTION_GAP_MS 5
+#define EPOCH_MS 100
+#define EPOCH_FRAMES 4
+#define STATION_PERIOD 10 // epochs between station frames, which new clients get from the cache
+#define TEST_TYPE 4094 // proprietary type, the payload holds a sequence number
+#define SOCKET_BUFFER 4096 // small, so slow rovers fill it and the caster drops frames
+#define ROVER_BUFFER 2048
+#define FANOUT_LEN 16384 // as the UART_RTCM3 one
+#define CLAIM_THREADS 4
+#define CLAIM_ROUNDS 20000
+#define CLAIM_HOLD 8
+
+static char status[STATUS_MAX][32];
+static fanout_t *rtcm3 = NULL;
+
+char *config_get(config_t type)
+{
+    return "";
+}
+
+char *status_get(status_t type)
+{
+    return status[type];
+}
+
+void uart_get_nav_pvt(ubx_nav_pvt_t *pvt)
+{
+    memset(pvt, 0, sizeof(ubx_nav_pvt_t));
+}
+
+fanout_t *uart_rtcm3_fanout()
+{
+    return rtcm3;
+}
+
+static _Atomic int owner[CLIENT_MAX]; // thread which holds a claimed slot, 0 when free or handed over
+static atomic_bool writer_done;
+static atomic_int claimed;
+static atomic_int rejected;
+static atomic_int served;
+static atomic_int unavailable;
+static atomic_int bad;
+static atomic_int frames;
+static atomic_int cached;
+
+static size_t frame_build(uint8_t *frame, uint16_t type, uint32_t seq, size_t payload_len)
+{
+    memset(frame, 0, RTCM3_HEADER_LEN + payload_len);
+    frame[0] = RTCM3_PREAMBLE;
+    frame[1] = payload_len >> 8;
+    frame[2] = payload_len & 0xFF;
+    frame[3] = type >> 4;
+    frame[4] = (type & 0x0F) << 4;
+    for (size_t i = 5; i < RTCM3_HEADER_LEN + payload_len; i++)
+    {
+        frame[i] = seq + i;
+    }
+    frame[5] = seq >> 24;
+    frame[6] = seq >> 16;
+    frame[7] = seq >> 8;
+    frame[8] = seq;
+
+    size_t len = RTCM3_HEADER_LEN + payload_len;
+    uint32_t crc = rtcm3_crc24q(frame, len);
+    frame[len++] = crc >> 16;
+    frame[len++] = crc >> 8;
+    frame[len++] = crc;
+    return len;
+}
+
+// the UART reader: one epoch of frames of various sizes every EPOCH_MS
+static void *writer_task(void *arg)
+{
+    uint8_t frame[RTCM3_FRAME_LEN_MAX];
+    uint32_t seq = 0;
+
+    for (int epoch = 0; !atomic_load(&writer_done); epoch++)
+    {
+        if (epoch % STATION_PERIOD == 0)
+        {
+            fanout_write(rtcm3, frame, frame_build(frame, 1005, 0, 19));
+        }
+        for (int i = 0; i < EPOCH_FRAMES; i++)
+        {
+            seq++;
+            fanout_write(rtcm3, frame, frame_build(frame, TEST_TYPE, seq, 20 + seq * 337 % 1000));
+        }
+        usleep(EPOCH_MS * 1000);
+    }
+    return NULL;
+}
+
+typedef struct rover_t
+{
+    int id;
+    int socket;
+    bool v2;
+    rtcm3_parser_t parser;
+    uint32_t frames; // frames out of the parser so far
+    uint32_t seq;    // last sequence number
+    bool ok;
+} rover_t;
+
+// each frame must be whole and valid, the test frames in order, the station frames only
+static void rover_frame(const uint8_t *frame, size_t len, void *ctx)
+{
+    rover_t *rover = ctx;
+    uint16_t type = rtcm3_msg_type(frame);
+
+    rover->frames++;
+    if (type == 1005)
+    {
+        atomic_fetch_add(&cached, rover->frames == 1);
+        return;
+    }
+
+    uint32_t seq = (uint32_t)frame[5] << 24 | (uint32_t)frame[6] << 16 | (uint32_t)frame[7] << 8 | frame[8];
+    if (type != TEST_TYPE || seq <= rover->seq)
+    {
+        printf("rover %d: frame %u of type %u after %u\n", rover->id, seq, type, rover->seq);
+        rover->ok = false;
+    }
+    rover->seq = seq;
+}
+
+// NTRIP v1 is a plain stream of frames, v2 has one frame in each chunk
+static size_t rover_parse(rover_t *rover, const uint8_t *data, size_t len)
+{
+    if (!rover->v2)
+    {
+        rtcm3_parser_feed(&rover->parser, data, len, rover_frame, rover);
+        return len;
+    }
+
+    const uint8_t *end = memchr(data, '\n', len);
+    if (end == NULL)
+    {
+        return 0;
+    }
+    size_t size = strtoul((const char *)data, NULL, 16);
+    size_t header = end + 1 - data;
+    if (header + size + 2 > len)
+    {
+        return 0;
+    }
+
+    uint32_t before = rover->frames;
+    rtcm3_parser_feed(&rover->parser, data + header, size, rover_frame, rover);
+    if (rover->frames != before + 1 || rover->parser.len != 0 || memcmp(data + header + size, "\r\n", 2) != 0)
+    {
+        printf("rover %d: chunk of %zu bytes is not one frame\n", rover->id, size);
+        rover->ok = false;
+    }
+    return header + size + 2;
+}
+
+// read the response, then the stream for a while, slow rovers let the caster queue fill up
+static void *rover_task(void *arg)
+{
+    rover_t *rover = arg;
+    uint8_t buffer[ROVER_BUFFER];
+    size_t len = 0;
+    bool slow = rover->id % 5 == 0;
+    uint32_t end_ms = xTaskGetTickCount() + (slow ? 300 : 50) + rover->id * 37 % 400;
+    const char *header_end = rover->v2 ? "\r\n\r\n" : "\r\n";
+    bool streaming = false;
+
+    rtcm3_parser_init(&rover->parser);
+    rover->ok = true;
+    while (rover->ok && xTaskGetTickCount() < end_ms)
+    {
+        struct pollfd readable = {.fd = rover->socket, .events = POLLIN};
+        if (poll(&readable, 1, 10) <= 0)
+        {
+            continue;
+        }
+        int n = read(rover->socket, buffer + len, slow ? MIN(64, sizeof(buffer) - len) : sizeof(buffer) - len);
+        if (n <= 0)
+        {
+            break;
+        }
+        len += n;
+
+        // the response comes first, any other byte before it is a send to a stale slot
+        if (!streaming)
+        {
+            bool found = false;
+            for (size_t i = 0; i + strlen(header_end) <= len && !found; i++)
+            {
+                found = memcmp(buffer + i, header_end, strlen(header_end)) == 0;
+            }
+            if (!found)
+            {
+                continue;
+            }
+            if (memcmp(buffer, "HTTP/1.0 503", 12) == 0)
+            {
+                atomic_fetch_add(&unavailable, 1);
+                break;
+            }
+            const char *response = rover->v2 ? STREAM_RESPONSE_V2 : STREAM_RESPONSE;
+            if (len < strlen(response) || memcmp(buffer, response, strlen(response)) != 0)
+            {
+                printf("rover %d: unexpected response %.*s\n", rover->id, (int)MIN(len, 16), buffer);
+                rover->ok = false;
+                break;
+            }
+            atomic_fetch_add(&served, 1);
+            streaming = true;
+            len -= strlen(response);
+            memmove(buffer, buffer + strlen(response), len);
+        }
+
+        size_t used;
+        uint8_t *data = buffer;
+        while (len > 0 && (used = rover_parse(rover, data, len)) > 0)
+        {
+            data += used;
+            len -= used;
+        }
+        memmove(buffer, data, len);
+        if (len == sizeof(buffer))
+        {
+            printf("rover %d: no frame in %zu bytes\n", rover->id, len);
+            rover->ok = false;
+        }
+
+        if (slow)
+        {
+            usleep(50000);
+        }
+    }
+
+    if (rover->parser.crc_errors || rover->parser.dropped_bytes)
+    {
+        printf("rover %d: %u CRC errors, %u bytes out of frames\n", rover->id,
+               (unsigned int)rover->parser.crc_errors, (unsigned int)rover->parser.dropped_bytes);
+        rover->ok = false;
+    }
+    atomic_fetch_add(&bad, !rover->ok);
+    atomic_fetch_add(&frames, rover->frames);
+    close(rover->socket);
+    return NULL;
+}
+
+// one connection after the other through the stream handler, like the single httpd task
+static void test_broadcast_churn(void)
+{
+    static rover_t rovers[CONNECTIONS];
+    pthread_t threads[CONNECTIONS];
+    pthread_t writer;
+
+    rtcm3 = fanout_create(FANOUT_LEN);
+    CHECK(ntrip_caster_init() == ESP_OK);
+    pthread_create(&writer, NULL, writer_task, NULL);
+
+    for (int i = 0; i < CONNECTIONS; i++)
+    {
+        int fds[2];
+        int size = SOCKET_BUFFER;
+        CHECK(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+        setsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+
+        rovers[i] = (rover_t){.id = i, .socket = fds[1], .v2 = i % 2};
+        pthread_create(&threads[i], NULL, rover_task, &rovers[i]);
+
+        httpd_req_t req = {
+            .uri = "/BASE",
+            .method = HTTP_GET,
+            .sockfd = fds[0],
+            .headers = rovers[i].v2 ? "Ntrip-Version: Ntrip/2.0\r\n" : "",
+        };
+        base_stream_handler(&req);
+        usleep(CONNECTION_GAP_MS * 1000);
+    }
+
+    for (int i = 0; i < CONNECTIONS; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    atomic_store(&writer_done, true);
+    pthread_join(writer, NULL);
+
+    // the caster task sees the last hang-ups
+    for (int i = 0; i < 100 && atomic_load(&client_count) > 0; i++)
+    {
+        usleep(10000);
+    }
+
+    printf("served %d, unavailable %d, bad %d, frames %d, cached first %d\n",
+           served, unavailable, bad, frames, cached);
+    CHECK(bad == 0);
+    CHECK(served + unavailable == CONNECTIONS);
+    CHECK(unavailable > 0);
+    CHECK(frames > served * 2);
+    CHECK(cached > 0);
+    CHECK(atomic_load(&client_count) == 0);
+    for (size_t i = 0; i < CLIENT_MAX; i++)
+    {
+        CHECK(atomic_load(&clients[i].state) == CLIENT_FREE);
+    }
+}
+
+static ntrip_caster_client_t *claim(int id)
+{
+    ntrip_caster_client_t *client = ntrip_caster_client_claim();
+    if (client == NULL)
+    {
+        atomic_fetch_add(&rejected, 1);
+        return NULL;
+    }
+
+    // nobody else may hold this slot
+    int expected = 0;
+    CHECK(atomic_compare_exchange_strong(&owner[client - clients], &expected, id));
+    CHECK(atomic_load(&client->state) == CLIENT_CLAIMED);
+    atomic_fetch_add(&claimed, 1);
+    return client;
+}
+
+// each thread holds up to CLAIM_HOLD slots at a time, together more than CLIENT_MAX
+static void *claim_task(void *arg)
+{
+    int id = (int)(intptr_t)arg;
+    ntrip_caster_client_t *held[CLAIM_HOLD];
+
+    for (int i = 0; i < CLAIM_ROUNDS; i++)
+    {
+        for (size_t j = 0; j < CLAIM_HOLD; j++)
+        {
+            // the claimer owns the whole slot until it is given back
+            held[j] = claim(id);
+            if (held[j])
+            {
+                held[j]->socket = id;
+            }
+        }
+        sched_yield();
+
+        for (size_t j = 0; j < CLAIM_HOLD; j++)
+        {
+            if (held[j])
+            {
+                CHECK(held[j]->socket == id);
+                atomic_store(&owner[held[j] - clients], 0);
+                atomic_store_explicit(&held[j]->state, CLIENT_FREE, memory_order_release);
+            }
+        }
+    }
+    return NULL;
+}
+
+static void test_claim_contention(void)
+{
+    pthread_t threads[CLAIM_THREADS];
+
+    for (intptr_t i = 0; i < CLAIM_THREADS; i++)
+    {
+        pthread_create(&threads[i], NULL, claim_task, (void *)(i + 1));
+    }
+    for (size_t i = 0; i < CLAIM_THREADS; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    printf("claimed %d, rejected %d\n", claimed, rejected);
+    CHECK(claimed + rejected == CLAIM_THREADS * CLAIM_ROUNDS * CLAIM_HOLD);
+    CHECK(rejected > 0);
+    for (size_t i = 0; i < CLIENT_MAX; i++)
+    {
+        CHECK(atomic_load(&clients[i].state) == CLIENT_FREE);
+    }
+}
+
+int main(void)
+{
+    // a rover may hang up while the caster is sending to it
+    signal(SIGPIPE, SIG_IGN);
+
+    TEST_RUN(test_broadcast_churn);
+    TEST_RUN(test_claim_contention);
+
+    return TEST_EXIT();
+}
@@ -0,0 +1,247 @@
+/*
+ * This file is part of the ESP32-GNSS-Base-Station firmware, published
+ * at (https://github.com/vuquangtrong/esp32-gnss-base-station).
+ * Copyright (c) 2023 Vu Quang Trong.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "nmea.h"
+#include "test.h"
+
+/*
+ * host replay of the status UART at 10 Hz through the NMEA line assembler:
+ * bursts of NMEA sentences and a UBX frame come at the wire speed, the driver model
+ * hands the buffered bytes over when its RX FIFO is full or on RX timeout,
+ * the latency of a sentence is from its LF on the wire to its callback
+ */
+
+#define BAUDRATE 115200
+#define BYTE_US (10 * 1000000 / BAUDRATE) // start, 8 data and stop bits
+#define FIFO_FULL 120 // default RX full threshold of the driver
+#define RX_TIMEOUT 10 // default RX timeout, in byte times
+#define EPOCH_US 100000 // 10 Hz
+#define EPOCHS 600
+#define STREAM_LEN (EPOCHS * 1200)
+#define SENTENCES_MAX (EPOCHS * 16)
+
+// one epoch as output by a ZED-F9P
+static const char *EPOCH[] = {
+    "$GNRMC,083559.00,A,2102.45711,N,10546.98733,E,0.011,,160826,,,D,V*1F",
+    "$GNVTG,,T,,M,0.011,N,0.020,K,D*3A",
+    "$GNGGA,083559.00,2102.45711,N,10546.98733,E,4,12,0.62,18.4,M,-23.1,M,1.0,0000*7A",
+    "$GNGSA,A,3,05,13,15,18,20,23,24,29,,,,,1.12,0.62,0.93,1*09",
+    "$GNGSA,A,3,70,71,72,86,87,,,,,,,,1.12,0.62,0.93,2*0B",
+    "$GNGSA,A,3,02,07,08,30,,,,,,,,,1.12,0.62,0.93,3*01",
+    "$GPGSV,3,1,11,05,48,063,45,13,29,311,42,15,61,211,47,18,24,041,40,1*6B",
+    "$GPGSV,3,2,11,20,18,292,38,23,35,159,44,24,71,032,48,29,09,107,33,1*6F",
+    "$GPGSV,3,3,11,02,04,241,,10,02,178,,46,45,235,43,1*58",
+    "$GLGSV,2,1,06,70,52,017,46,71,39,088,44,72,05,121,35,86,31,235,41,1*7C",
+    "$GLGSV,2,2,06,87,65,326,47,88,14,302,,1*72",
+    "$GAGSV,1,1,04,02,23,201,41,07,66,331,47,08,29,087,43,30,40,134,45,7*7C",
+    "$GNGST,083559.00,12,0.010,0.008,48.5,0.009,0.008,0.014*52",
+    "$GNGLL,2102.45711,N,10546.98733,E,083559.00,A,D*77",
+};
+#define EPOCH_SENTENCES (sizeof(EPOCH) / sizeof(EPOCH[0]))
+#define UBX_AFTER 2 // the UBX-NAV-PVT frame comes after RMC and VTG
+
+typedef struct replay_t
+{
+    uint8_t stream[STREAM_LEN];
+    uint32_t arrival_us[STREAM_LEN]; // when each byte is received
+    size_t len;
+    uint32_t lf_us[SENTENCES_MAX]; // when the LF of each sentence is received
+    const char *sentence[SENTENCES_MAX];
+    size_t sentences;
+    size_t received;
+    uint32_t now_us;
+    uint32_t latency_max_us;
+    uint64_t latency_sum_us;
+    size_t mismatches;
+} replay_t;
+
+static replay_t replay;
+
+static void replay_append(const uint8_t *data, size_t len, uint32_t *t)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        replay.stream[replay.len] = data[i];
+        replay.arrival_us[replay.len] = *t;
+        replay.len++;
+        *t += BYTE_US;
+    }
+}
+
+// NAV-PVT with '$' and LF in its payload, as in real binary data
+static void replay_append_ubx(uint32_t *t)
+{
+    uint8_t frame[8 + 92];
+    frame[0] = 0xB5;
+    frame[1] = 0x62;
+    frame[2] = 0x01;
+    frame[3] = 0x07;
+    frame[4] = 92;
+    frame[5] = 0;
+    for (size_t i = 0; i < 92; i++)
+    {
+        frame[6 + i] = i % 7 == 0 ? '$' : i % 11 == 0 ? '\n' : i;
+    }
+
+    uint8_t ck_a = 0, ck_b = 0;
+    for (size_t i = 2; i < 6 + 92; i++)
+    {
+        ck_a += frame[i];
+        ck_b += ck_a;
+    }
+    frame[98] = ck_a;
+    frame[99] = ck_b;
+    replay_append(frame, sizeof(frame), t);
+}
+
+static void replay_build(void)
+{
+    memset(&replay, 0, sizeof(replay));
+    for (size_t epoch = 0; epoch < EPOCHS; epoch++)
+    {
+        uint32_t t = epoch * EPOCH_US;
+        for (size_t i = 0; i < EPOCH_SENTENCES; i++)
+        {
+            if (i == UBX_AFTER)
+            {
+                replay_append_ubx(&t);
+            }
+            replay_append((const uint8_t *)EPOCH[i], strlen(EPOCH[i]), &t);
+            replay_append((const uint8_t *)"\r\n", 2, &t);
+            replay.lf_us[replay.sentences] = t - BYTE_US;
+            replay.sentence[replay.sentences] = EPOCH[i];
+            replay.sentences++;
+        }
+        // each burst must fit in its epoch at this baudrate
+        CHECK(t <= (epoch + 1) * EPOCH_US);
+    }
+}
+
+static void on_sentence(const char *sentence, size_t len, void *ctx)
+{
+    if (replay.received < replay.sentences)
+    {
+        if (strcmp(sentence, replay.sentence[replay.received]) != 0 || len != strlen(sentence))
+        {
+            replay.mismatches++;
+        }
+
+        uint32_t latency = replay.now_us - replay.lf_us[replay.received];
+        replay.latency_sum_us += latency;
+        if (latency > replay.latency_max_us)
+        {
+            replay.latency_max_us = latency;
+        }
+    }
+    replay.received++;
+}
+
+// the driver posts UART_DATA when FIFO_FULL bytes are buffered, or RX_TIMEOUT byte times after the last byte
+static void replay_run(nmea_parser_t *parser)
+{
+    size_t start = 0;
+
+    for (size_t i = 0; i < replay.len; i++)
+    {
+        bool full = i + 1 - start == FIFO_FULL;
+        bool idle = i + 1 == replay.len || replay.arrival_us[i + 1] - replay.arrival_us[i] > RX_TIMEOUT * BYTE_US;
+        if (!full && !idle)
+        {
+            continue;
+        }
+
+        replay.now_us = replay.arrival_us[i] + (full ? BYTE_US : RX_TIMEOUT * BYTE_US);
+        nmea_parser_feed(parser, replay.stream + start, i + 1 - start, on_sentence, NULL);
+        start = i + 1;
+    }
+}
+
+static void test_replay_10hz(void)
+{
+    nmea_parser_t parser;
+
+    replay_build();
+    nmea_parser_init(&parser);
+    replay_run(&parser);
+
+    printf("%zu sentences at 10 Hz, %d baud: latency mean %.2f ms, max %.2f ms\n",
+           replay.received, BAUDRATE,
+           replay.latency_sum_us / 1000.0 / (replay.received ? replay.received : 1),
+           replay.latency_max_us / 1000.0);
+    CHECK(replay.received == replay.sentences);
+    CHECK(replay.mismatches == 0);
+    CHECK(parser.overflows == 0);
+    // a sentence waits at most for a full FIFO or the RX timeout
+    CHECK(replay.latency_max_us <= (FIFO_FULL + RX_TIMEOUT) * BYTE_US);
+}
+
+static void test_replay_one_byte(void)
+{
+    nmea_parser_t parser;
+    size_t sentences = 0;
+
+    // the old reader got one byte per read
+    replay_build();
+    nmea_parser_init(&parser);
+    for (size_t i = 0; i < replay.len; i++)
+    {
+        replay.now_us = replay.arrival_us[i];
+        sentences += nmea_parser_feed(&parser, replay.stream + i, 1, on_sentence, NULL);
+    }
+    CHECK(sentences == replay.sentences);
+    CHECK(replay.mismatches == 0);
+    CHECK(replay.latency_max_us == 0);
+}
+
+static void test_broken_sentences(void)
+{
+    nmea_parser_t parser;
+    size_t sentences;
+    char stream[512];
+
+    nmea_parser_init(&parser);
+
+    // bad checksum, then a sentence cut by a new '$', then a good one
+    snprintf(stream, sizeof(stream), "%s", "$GNVTG,,T,,M,0.011,N,0.020,K,D*3B\r\n$GNGGA,0835$GNVTG,,T,,M,0.011,N,0.020,K,D*3A\r\n");
+    sentences = nmea_parser_feed(&parser, (const uint8_t *)stream, strlen(stream), NULL, NULL);
+    CHECK(sentences == 1);
+    CHECK(parser.checksum_errors == 1);
+
+    // a line longer than NMEA_LEN_MAX is dropped, the next one comes out
+    memset(stream, 'A', 200);
+    stream[0] = '$';
+    snprintf(stream + 200, sizeof(stream) - 200, "\r\n%s\r\n", EPOCH[1]);
+    sentences = nmea_parser_feed(&parser, (const uint8_t *)stream, strlen(stream), NULL, NULL);
+    CHECK(sentences == 1);
+    CHECK(parser.overflows == 1);
+
+    // LF without CR
+    snprintf(stream, sizeof(stream), "%s\n", EPOCH[0]);
+    CHECK(nmea_parser_feed(&parser, (const uint8_t *)stream, strlen(stream), NULL, NULL) == 1);
+}
+
+int main(void)
+{
+    TEST_RUN(test_replay_10hz);
+    TEST_RUN(test_replay_one_byte);
+    TEST_RUN(test_broken_sentences);
+
+    return TEST_EXIT();
+}
@@ -0,0 +1,288 @@
+/*
+ * This file is part of the ESP32-GNSS-Base-Station firmware, published
+ * at (https://github.com/vuquangtrong/esp32-gnss-base-station).
+ * Copyright (c) 2023 Vu Quang Trong.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "rtcm3.h"
+#include "test.h"
+
+// host test of the RTCM3 frame parser and the message type filter
+
+typedef struct frames_t
+{
+    size_t count;
+    size_t len[64];
+    uint16_t type[64];
+} frames_t;
+
+static void on_frame(const uint8_t *frame, size_t len, void *ctx)
+{
+    frames_t *frames = ctx;
+    if (frames->count < 64)
+    {
+        frames->len[frames->count] = len;
+        frames->type[frames->count] = rtcm3_msg_type(frame);
+    }
+    frames->count++;
+}
+
+// bit by bit CRC-24Q, to check the table
+static uint32_t crc24q_bitwise(const uint8_t *data, size_t len)
+{
+    uint32_t crc = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        crc ^= (uint32_t)data[i] << 16;
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc <<= 1;
+            if (crc & 0x1000000)
+            {
+                crc ^= 0x1864CFB;
+            }
+        }
+    }
+    return crc & 0xFFFFFF;
+}
+
+// build a frame of the given type and payload length, return the frame length
+static size_t make_frame(uint8_t *frame, uint16_t type, size_t payload_len)
+{
+    frame[0] = RTCM3_PREAMBLE;
+    frame[1] = payload_len >> 8;
+    frame[2] = payload_len & 0xFF;
+    for (size_t i = 0; i < payload_len; i++)
+    {
+        frame[RTCM3_HEADER_LEN + i] = rand();
+    }
+    frame[3] = type >> 4;
+    frame[4] = (frame[4] & 0x0F) | ((type & 0x0F) << 4);
+
+    uint32_t crc = rtcm3_crc24q(frame, RTCM3_HEADER_LEN + payload_len);
+    frame[RTCM3_HEADER_LEN + payload_len + 0] = crc >> 16;
+    frame[RTCM3_HEADER_LEN + payload_len + 1] = crc >> 8;
+    frame[RTCM3_HEADER_LEN + payload_len + 2] = crc;
+    return RTCM3_HEADER_LEN + payload_len + RTCM3_CRC_LEN;
+}
+
+static void test_crc24q(void)
+{
+    uint8_t data[256];
+    for (size_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = rand();
+    }
+
+    for (size_t len = 0; len <= sizeof(data); len += 17)
+    {
+        CHECK(rtcm3_crc24q(data, len) == crc24q_bitwise(data, len));
+    }
+    // check value of the Qualcomm CRC-24
+    CHECK(rtcm3_crc24q((const uint8_t *)"123456789", 9) == 0xCDE703);
+}
+
+static void test_resync_after_garbage(void)
+{
+    rtcm3_parser_t parser;
+    frames_t frames = {0};
+    uint8_t stream[512];
+    size_t len = 0;
+
+    // garbage with false preambles, one of them with a valid looking header
+    const uint8_t garbage[] = {0x00, 0xD3, 0xFF, 0x12, 0xD3, 0x00, 0x05, 0x01, 0x02, 0xD3};
+    memcpy(stream, garbage, sizeof(garbage));
+    len += sizeof(garbage);
+    len += make_frame(stream + len, 1005, 19);
+    stream[len++] = 0x55;
+    len += make_frame(stream + len, 1074, 100);
+
+    rtcm3_parser_init(&parser);
+    CHECK(rtcm3_parser_feed(&parser, stream, len, on_frame, &frames) == 2);
+    CHECK(frames.count == 2);
+    CHECK(frames.type[0] == 1005 && frames.len[0] == 19 + 6);
+    CHECK(frames.type[1] == 1074 && frames.len[1] == 100 + 6);
+    CHECK(parser.dropped_bytes == sizeof(garbage) + 1);
+}
+
+static void test_split_header(void)
+{
+    rtcm3_parser_t parser;
+    frames_t frames = {0};
+    uint8_t stream[256];
+    size_t len = make_frame(stream, 1077, 200);
+
+    // one byte at a time, the header comes in three parts
+    rtcm3_parser_init(&parser);
+    for (size_t i = 0; i < len; i++)
+    {
+        CHECK(rtcm3_parser_feed(&parser, stream + i, 1, on_frame, &frames) == (i == len - 1 ? 1 : 0));
+        if (i == 0)
+        {
+            CHECK(rtcm3_parser_wanted(&parser) == 2);
+        }
+    }
+    CHECK(frames.count == 1 && frames.type[0] == 1077);
+
+    // header split after the preamble and after the first length byte
+    for (size_t cut = 1; cut < RTCM3_HEADER_LEN; cut++)
+    {
+        memset(&frames, 0, sizeof(frames));
+        rtcm3_parser_init(&parser);
+        CHECK(rtcm3_parser_feed(&parser, stream, cut, on_frame, &frames) == 0);
+        CHECK(rtcm3_parser_feed(&parser, stream + cut, len - cut, on_frame, &frames) == 1);
+        CHECK(frames.count == 1 && frames.len[0] == len);
+        CHECK(parser.dropped_bytes == 0);
+    }
+}
+
+static void test_crc_failure(void)
+{
+    rtcm3_parser_t parser;
+    frames_t frames = {0};
+    uint8_t stream[512];
+    size_t first = make_frame(stream, 1087, 120);
+    size_t len = first + make_frame(stream + first, 1097, 80);
+
+    // corrupt the first frame, the second one must still come out
+    stream[RTCM3_HEADER_LEN + 10] ^= 0x01;
+
+    rtcm3_parser_init(&parser);
+    CHECK(rtcm3_parser_feed(&parser, stream, len, on_frame, &frames) == 1);
+    CHECK(frames.count == 1 && frames.type[0] == 1097);
+    CHECK(parser.crc_errors >= 1);
+    CHECK(parser.dropped_bytes == first);
+}
+
+static void test_max_length(void)
+{
+    rtcm3_parser_t parser;
+    frames_t frames = {0};
+    uint8_t stream[2 * RTCM3_FRAME_LEN_MAX];
+    size_t len = make_frame(stream, 1230, RTCM3_PAYLOAD_LEN_MAX);
+    CHECK(len == RTCM3_FRAME_LEN_MAX);
+    len += make_frame(stream + len, 1230, RTCM3_PAYLOAD_LEN_MAX);
+
+    rtcm3_parser_init(&parser);
+    CHECK(rtcm3_parser_feed(&parser, stream, len, on_frame, &frames) == 2);
+    CHECK(frames.count == 2 && frames.len[0] == RTCM3_FRAME_LEN_MAX && frames.len[1] == RTCM3_FRAME_LEN_MAX);
+    CHECK(parser.crc_errors == 0 && parser.dropped_bytes == 0);
+
+    // reserved bits set, the length would be over the maximum
+    const uint8_t bad[] = {RTCM3_PREAMBLE, 0x04, 0x00};
+    memset(&frames, 0, sizeof(frames));
+    rtcm3_parser_init(&parser);
+    CHECK(rtcm3_parser_feed(&parser, bad, sizeof(bad), on_frame, &frames) == 0);
+    CHECK(parser.len == 0 && parser.dropped_bytes == sizeof(bad));
+}
+
+static void test_random_chunks(void)
+{
+    static uint8_t stream[64 * 1024];
+    static const uint16_t types[] = {1005, 1074, 1084, 1094, 1124, 1230};
+    rtcm3_parser_t parser;
+    frames_t frames = {0};
+    size_t len = 0;
+    size_t count = 0;
+
+    while (len + RTCM3_FRAME_LEN_MAX + 8 < sizeof(stream))
+    {
+        len += make_frame(stream + len, types[count % 6], rand() % (RTCM3_PAYLOAD_LEN_MAX + 1));
+        count++;
+        if (rand() % 4 == 0)
+        {
+            stream[len++] = rand() % 2 ? RTCM3_PREAMBLE : 0x00;
+        }
+    }
+
+    rtcm3_parser_init(&parser);
+    size_t emitted = 0;
+    for (size_t i = 0; i < len;)
+    {
+        size_t n = 1 + rand() % 1500;
+        n = n > len - i ? len - i : n;
+        emitted += rtcm3_parser_feed(&parser, stream + i, n, on_frame, &frames);
+        i += n;
+    }
+    // a lost frame after a stray preamble is possible, but never a bad one
+    CHECK(emitted == frames.count);
+    CHECK(emitted + parser.crc_errors >= count - count / 20);
+    CHECK(emitted <= count);
+}
+
+static void test_filter_parse(void)
+{
+    rtcm3_filter_t filter;
+
+    CHECK(rtcm3_filter_parse(&filter, ""));
+    CHECK(filter.count == 0);
+
+    CHECK(rtcm3_filter_parse(&filter, "1005:10,1074,1230:5"));
+    CHECK(filter.count == 3);
+    CHECK(filter.type[0] == 1005 && filter.decimation[0] == 10);
+    CHECK(filter.type[1] == 1074 && filter.decimation[1] == 1);
+    CHECK(filter.type[2] == 1230 && filter.decimation[2] == 5);
+
+    // rejected filters are left empty
+    CHECK(!rtcm3_filter_parse(&filter, "1005,"));
+    CHECK(filter.count == 0);
+    CHECK(!rtcm3_filter_parse(&filter, ",1005"));
+    CHECK(!rtcm3_filter_parse(&filter, "1005,,1074"));
+    CHECK(!rtcm3_filter_parse(&filter, "1005:"));
+    CHECK(!rtcm3_filter_parse(&filter, "1005:0"));
+    CHECK(!rtcm3_filter_parse(&filter, "1005:70000"));
+    CHECK(!rtcm3_filter_parse(&filter, "4096"));
+    CHECK(!rtcm3_filter_parse(&filter, "1005;1074"));
+    CHECK(!rtcm3_filter_parse(&filter, "1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17"));
+    CHECK(rtcm3_filter_parse(&filter, "1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16"));
+    CHECK(filter.count == RTCM3_FILTER_TYPES_MAX);
+}
+
+static void test_filter_pass(void)
+{
+    rtcm3_filter_t filter;
+    int passed = 0;
+
+    CHECK(rtcm3_filter_parse(&filter, "1005:10,1074"));
+    for (int i = 0; i < 100; i++)
+    {
+        passed += rtcm3_filter_pass(&filter, 1005);
+    }
+    CHECK(passed == 10);
+    CHECK(rtcm3_filter_pass(&filter, 1074));
+    CHECK(!rtcm3_filter_pass(&filter, 1084));
+
+    CHECK(rtcm3_filter_parse(&filter, ""));
+    CHECK(rtcm3_filter_pass(&filter, 1084));
+}
+
+int main(void)
+{
+    srand(1);
+
+    TEST_RUN(test_crc24q);
+    TEST_RUN(test_resync_after_garbage);
+    TEST_RUN(test_split_header);
+    TEST_RUN(test_crc_failure);
+    TEST_RUN(test_max_length);
+    TEST_RUN(test_random_chunks);
+    TEST_RUN(test_filter_parse);
+    TEST_RUN(test_filter_pass);
+
+    return TEST_EXIT();
+}